@@ -0,0 +1,653 @@
+//
+//  benchmark.cpp
+//
+//  Benchmarks of the heaps and graph algorithms in the repository on
+//  synthetic graphs (graph-generators.hpp). Results are printed as CSV
+//  or JSON, one record per benchmark, so runs of two versions can be
+//  compared.
+//
+//  build:
+//      g++ -std=c++11 -O2 -pthread -o benchmark benchmark.cpp
+//          "../Shortest Paths/Dijkstras Fibonacci Heap/fibonacci-heap.cpp"
+//
+//      -mavx2 (or -march=native) for the AVX2 edge relaxation of
+//      bellman_ford_edge_arrays
+//
+//  usage:
+//      benchmark [--format csv|json] [--seed S] [--scale K] [--reps R]
+//                [--filter substring]
+//
+//      --scale multiplies all the problem sizes (default 1)
+//      --reps  runs of every benchmark, the fastest one is reported
+//      --filter runs only benchmarks whose name contains substring
+//
+//  Columns
+//      benchmark, graph    what was run and on which input
+//      n, m                vertices and edges (elements and operations
+//                          for heaps and disjoint sets)
+//      seconds             fastest run
+//      ns_per_op           seconds / m in nanoseconds, op is an edge for
+//                          graph algorithms
+//      edges_per_s         m / seconds
+//      peak_rss_kb         peak resident memory during the benchmark,
+//                          (VmHWM, reset before each benchmark on Linux;
+//                          otherwise peak of the whole process so far)
+//
+//  Created by mkuklik on 12/1/15.
+//  Copyright © 2015 mkuklik. All rights reserved.
+//
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <queue>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <cstdlib>
+#include <cstring>
+#include <sys/resource.h>
+
+#include "graph-generators.hpp"
+
+#include "../Binary Heap/binary-heap.hpp"
+#include "../D-ary Heap/dary-heap.hpp"
+#include "../Radix Heap/radix-heap.hpp"
+#include "../Pairing Heap/pairing-heap.hpp"
+#include "../Shortest Paths/Dijkstras stdlib heap/dijkstras-stdlib-heap.hpp"
+#include "../Shortest Paths/Dijkstras Fibonacci Heap/dijkstras-fibonacci-heap.hpp"
+#include "../Shortest Paths/Dijkstra Query/dijkstra-query.hpp"
+#include "../Shortest Paths/Dijkstra Query/bidirectional-dijkstra.hpp"
+#include "../Shortest Paths/A Star/a-star.hpp"
+#include "../Shortest Paths/A Star/landmarks.hpp"
+#include "../Shortest Paths/Contraction Hierarchies/ch-query.hpp"
+#include "../Shortest Paths/Multi Source/multi-source.hpp"
+#include "../Shortest Paths/Delta Stepping/delta-stepping.hpp"
+#include "../Shortest Paths/Bellman Ford/bellman-ford.hpp"
+#include "../Shortest Paths/Johnson/johnson.hpp"
+#include "../Maximum Flow/max-flow.hpp"
+#include "../Disjoint Sets/disjoint_set_forest.hpp"
+#include "../Disjoint Sets/concurrent_disjoint_set_forest.hpp"
+
+using namespace std;
+
+/*
+ *  peak resident set size
+ */
+
+void reset_peak_rss() {
+    // Linux >= 4.0 resets VmHWM to the current RSS
+    ofstream f("/proc/self/clear_refs");
+    if (f) f << "5";
+}
+
+long peak_rss_kb() {
+    ifstream f("/proc/self/status");
+    string line;
+    while (getline(f, line))
+        if (line.compare(0, 6, "VmHWM:") == 0)
+            return atol(line.c_str() + 6);
+
+    // no procfs, peak of the whole process
+    struct rusage r;
+    getrusage(RUSAGE_SELF, &r);
+#ifdef __APPLE__
+    return r.ru_maxrss / 1024;      // bytes on macOS
+#else
+    return r.ru_maxrss;
+#endif
+}
+
+
+/*
+ *  Benchmark runner
+ */
+
+struct Result {
+    string benchmark;
+    string graph;
+    long n;
+    long m;
+    int reps;
+    double seconds;
+    long peak_rss_kb;
+};
+
+class Benchmark {
+
+    int reps;
+    string filter;
+    vector<Result> results;
+
+public:
+
+    Benchmark(int r, const string &f): reps(r), filter(f) {};
+
+    bool enabled(const string &name) {
+        return filter.empty() || name.find(filter) != string::npos;
+    }
+
+    /*
+     *  any_enabled, whether any of a group's benchmarks runs; groups
+     *      check it before building their graphs and inputs
+     */
+
+    bool any_enabled(initializer_list<const char *> names) {
+        for (auto name : names)
+            if (enabled(name)) return true;
+        return false;
+    }
+
+    /*
+     *  run, times f reps times and keeps the fastest run,
+     *      setup runs before every run and is not timed
+     */
+
+    void run(const string &name, const string &graph, long n, long m,
+             const function<void()> &f, const function<void()> &setup = nullptr) {
+
+        if (!enabled(name)) return;
+
+        reset_peak_rss();
+
+        double best {1e300};
+
+        for (int r=0; r<reps; r++) {
+            if (setup) setup();
+
+            auto t0 = chrono::steady_clock::now();
+            f();
+            auto t1 = chrono::steady_clock::now();
+
+            best = min(best, chrono::duration<double>(t1 - t0).count());
+        }
+
+        results.push_back(Result {name, graph, n, m, reps, best, peak_rss_kb()});
+
+        cerr << name << " " << graph << " n=" << n << " m=" << m << " " << best << "s" << endl;
+    }
+
+    void print_csv(ostream &out) {
+        out << "benchmark,graph,n,m,reps,seconds,ns_per_op,edges_per_s,peak_rss_kb\n";
+        for (auto &r : results)
+            out << r.benchmark << "," << r.graph << "," << r.n << "," << r.m << "," <<
+                   r.reps << "," << r.seconds << "," << 1e9 * r.seconds / r.m << "," <<
+                   r.m / r.seconds << "," << r.peak_rss_kb << "\n";
+    }
+
+    void print_json(ostream &out) {
+        out << "[\n";
+        for (size_t i=0; i<results.size(); i++) {
+            auto &r = results[i];
+            out << "  {\"benchmark\": \"" << r.benchmark << "\", \"graph\": \"" << r.graph <<
+                   "\", \"n\": " << r.n << ", \"m\": " << r.m << ", \"reps\": " << r.reps <<
+                   ", \"seconds\": " << r.seconds << ", \"ns_per_op\": " << 1e9 * r.seconds / r.m <<
+                   ", \"edges_per_s\": " << r.m / r.seconds << ", \"peak_rss_kb\": " << r.peak_rss_kb <<
+                   "}" << (i+1 < results.size() ? "," : "") << "\n";
+        }
+        out << "]\n";
+    }
+};
+
+
+/*
+ *  graph inputs
+ */
+
+struct Input {
+    string name;
+    int n;
+    EdgeList edges;
+};
+
+vector<Input> graphs(long size, uint64_t seed) {
+
+    vector<Input> in;
+
+    int side = 1;
+    while ((long) side * side < size) ++side;
+
+    int scale = 1;
+    while ((1L << scale) < size) ++scale;
+
+    in.push_back(Input {"gnm", (int) size, gnm((int) size, 8 * size, seed)});
+    in.push_back(Input {"grid", side * side, grid(side, side, seed)});
+    in.push_back(Input {"rmat", 1 << scale, rmat(scale, 8L << scale, seed)});
+
+    return in;
+}
+
+
+/*
+ *  benchmarks
+ */
+
+void bench_shortest_paths(Benchmark &b, long scale, uint64_t seed) {
+
+    if (!b.any_enabled({"dijkstra_binary_heap", "dijkstra_fibonacci_heap", "dijkstra_radix_heap",
+                        "dijkstra_pairing_heap", "multi_source_dijkstra", "batched_dijkstra",
+                        "dijkstra_binary_heap_each", "delta_stepping", "dijkstra_query_p2p",
+                        "bidirectional_dijkstra_p2p", "alt_p2p", "ch_preprocessing", "ch_p2p",
+                        "bellman_ford", "bellman_ford_spfa", "bellman_ford_edge_arrays",
+                        "bellman_ford_parallel"}))
+        return;
+
+    for (long size : {10000L * scale, 100000L * scale, 1000000L * scale})
+        for (auto &in : graphs(size, seed)) {
+
+            CSRGraph<int> g(in.n, in.edges);
+            long m = g.n_edges();
+            vector<int> dist, previous;
+
+            b.run("dijkstra_binary_heap", in.name, in.n, m,
+                  [&] { dijkstras_binary_heap(g, 0, dist, previous); });
+
+            b.run("dijkstra_fibonacci_heap", in.name, in.n, m,
+                  [&] { dijkstras_fibonacci_heap(g, 0, dist, previous); });
+
+            b.run("dijkstra_radix_heap", in.name, in.n, m,
+                  [&] { dijkstras_heap<RadixHeap<int>>(g, 0, dist, previous); });
+
+            b.run("dijkstra_pairing_heap", in.name, in.n, m,
+                  [&] { dijkstras_heap<PairingHeap<int>>(g, 0, dist, previous); });
+
+            // 16 sources, nearest one and all of them (m = 16 edges)
+            vector<int> depots(16);
+            for (size_t k=0; k<depots.size(); k++)
+                depots[k] = (int) (k * in.n / depots.size());
+
+            vector<int> origin;
+            b.run("multi_source_dijkstra", in.name, in.n, m,
+                  [&] { multi_source_dijkstra(g, depots, dist, previous, origin); });
+
+            if (size <= 100000 * scale) {
+                vector<int> rows, prev_rows;
+                b.run("batched_dijkstra", in.name, in.n, m * (long) depots.size(),
+                      [&] { batched_dijkstra(g, depots, rows, prev_rows); });
+
+                b.run("dijkstra_binary_heap_each", in.name, in.n, m * (long) depots.size(), [&] {
+                    for (auto s : depots) dijkstras_binary_heap(g, s, dist, previous);
+                });
+            }
+
+            b.run("delta_stepping", in.name, in.n, m,
+                  [&] { delta_stepping(g, 0, dist, previous, 50); });
+
+            // 100 random point to point queries, m = 100 edges
+            mt19937_64 rng(seed);
+            vector<pair<int, int>> st(100);
+            for (auto &q : st)
+                q = make_pair((int) uniform(rng, in.n), (int) uniform(rng, in.n));
+
+            DijkstraQuery q(g);
+            b.run("dijkstra_query_p2p", in.name, in.n, (long) st.size(),
+                  [&] { for (auto &x : st) q.run(x.first, x.second); });
+
+            if (b.enabled("bidirectional_dijkstra_p2p")) {
+                BidirectionalDijkstraQuery bq(g);
+                b.run("bidirectional_dijkstra_p2p", in.name, in.n, (long) st.size(),
+                      [&] { for (auto &x : st) bq.run(x.first, x.second); });
+            }
+
+            if (b.enabled("alt_p2p")) {
+                Landmarks lm(g, 16);
+                b.run("alt_p2p", in.name, in.n, (long) st.size(), [&] {
+                    for (auto &x : st)
+                        astar_binary_heap(g, x.first, x.second, ALTHeuristic(lm, x.second), dist, previous);
+                });
+            }
+
+            // contraction hierarchies are for road-like graphs, on random
+            // graphs the core gets dense and preprocessing takes forever
+            if (in.name == "grid" && size <= 100000L * scale &&
+                b.any_enabled({"ch_preprocessing", "ch_p2p"})) {
+                unique_ptr<ContractionHierarchy> ch;
+                b.run("ch_preprocessing", in.name, in.n, m,
+                      [&] { ch.reset(new ContractionHierarchy(g)); });
+
+                if (!ch) ch.reset(new ContractionHierarchy(g));     // ch_p2p only
+
+                CHQuery chq(*ch);
+                b.run("ch_p2p", in.name, in.n, (long) st.size(),
+                      [&] { for (auto &x : st) chq.run(x.first, x.second); });
+            }
+
+            if (!b.any_enabled({"bellman_ford", "bellman_ford_spfa", "bellman_ford_edge_arrays",
+                                "bellman_ford_parallel"}))
+                continue;
+
+            BellmanFord bf(g);
+
+            if (size <= 10000L * scale)
+                b.run("bellman_ford", in.name, in.n, m,
+                      [&] { bf.shortestPathFrom(0); });
+
+            b.run("bellman_ford_spfa", in.name, in.n, m,
+                  [&] { bf.shortestPathFrom(0, SPFA); });
+
+            if (size <= 10000L * scale)
+                b.run("bellman_ford_edge_arrays", in.name, in.n, m,
+                      [&] { bf.shortestPathFrom(0, EDGE_ARRAYS); });
+
+            if (size <= 100000L * scale)
+                b.run("bellman_ford_parallel", in.name, in.n, m,
+                      [&] { bf.shortestPathFrom(0, PARALLEL); });
+        }
+}
+
+void bench_all_pairs(Benchmark &b, long scale, uint64_t seed) {
+
+    if (!b.any_enabled({"johnson", "batched_dijkstra_all"})) return;
+
+    for (long size : {2000L * scale})
+        for (auto &in : graphs(size, seed)) {
+
+            CSRGraph<int> g(in.n, in.edges);
+            long m = g.n_edges() * (long) in.n;     // every edge from every source
+
+            // negative edges without negative cycles, w + p(u) - p(v)
+            mt19937_64 rng(seed);
+            vector<int> p(in.n);
+            for (auto &x : p) x = (int) uniform(rng, 100);
+
+            CSRGraph<int> neg(g);
+            for (int u=0; u<in.n; u++)
+                for (int i=g.offset[u]; i<g.offset[u+1]; i++)
+                    neg.value[i] = g.value[i] + p[u] - p[g.target[i]];
+
+            vector<int> all(in.n);
+            for (int v=0; v<in.n; v++) all[v] = v;
+
+            DistanceMatrix d(in.n, in.n);
+
+            b.run("johnson", in.name, in.n, m, [&] { johnson(neg, d); });
+
+            b.run("batched_dijkstra_all", in.name, in.n, m,
+                  [&] { batched_dijkstra(g, all, d.data(), nullptr); });
+        }
+}
+
+void bench_max_flow(Benchmark &b, long scale, uint64_t seed) {
+
+    if (!b.any_enabled({"edmonds_karp", "dinic", "push_relabel"})) return;
+
+    for (long size : {1000L * scale, 10000L * scale})
+        for (auto &in : graphs(size, seed)) {
+
+            CSRResidualGraph<int> g(in.n, in.edges);
+            long m = g.n_edges();
+            int t = in.n - 1;
+
+            if (size <= 1000L * scale)
+                b.run("edmonds_karp", in.name, in.n, m,
+                      [&] { max_flow(g, 0, t, EDMONDS_KARP); });
+
+            b.run("dinic", in.name, in.n, m,
+                  [&] { max_flow(g, 0, t, DINIC); });
+
+            b.run("push_relabel", in.name, in.n, m,
+                  [&] { max_flow(g, 0, t, PUSH_RELABEL); });
+        }
+}
+
+void bench_disjoint_sets(Benchmark &b, long scale, uint64_t seed) {
+
+    if (!b.any_enabled({"disjoint_set_forest", "connected_components"})) return;
+
+    for (long n : {100000L * scale, 10000000L * scale}) {
+
+        EdgeList e = gnm((int) n, n, seed);
+        vector<pair<int, int>> pairs;
+        pairs.reserve(e.size());
+        for (auto &x : e)
+            pairs.push_back(make_pair(x.from, x.to));
+
+        b.run("disjoint_set_forest", "gnm", n, (long) pairs.size(), [&] {
+            DisjointSetForest d((int) n);
+            for (auto &p : pairs)
+                d.join(p.first, p.second);
+        });
+
+        vector<int> component;
+        b.run("connected_components", "gnm", n, (long) pairs.size(), [&] {
+            connected_components((int) n, pairs, component);
+        });
+    }
+}
+
+void bench_heaps(Benchmark &b, long scale, uint64_t seed) {
+
+    if (!b.any_enabled({"std_priority_queue", "dary_heap_4", "dary_heap_8", "indexed_binary_heap",
+                        "fibonacci_heap", "pairing_heap", "radix_heap_monotone",
+                        "fibonacci_heap_monotone", "heapify", "dary_heap_4_heapify",
+                        "indexed_binary_heap_decrease_key", "pairing_heap_decrease_key",
+                        "indexed_dary_heap_4_decrease_key", "fibonacci_heap_decrease_key",
+                        "indexed_binary_heap_insert", "indexed_binary_heap_insert_range",
+                        "indexed_binary_heap_reinsert", "indexed_binary_heap_meld",
+                        "fibonacci_heap_insert", "fibonacci_heap_meld"}))
+        return;
+
+    for (long n : {100000L * scale, 1000000L * scale}) {
+
+        mt19937_64 rng(seed);
+        vector<int> keys(n);
+        for (auto &k : keys)
+            k = (int) uniform(rng, 1L << 30);
+
+        // n inserts followed by n extract-min, m = 2n operations
+
+        b.run("std_priority_queue", "random", n, 2*n, [&] {
+            priority_queue<int, vector<int>, greater<int>> pq;
+            for (auto k : keys) pq.push(k);
+            while (!pq.empty()) pq.pop();
+        });
+
+        b.run("dary_heap_4", "random", n, 2*n, [&] {
+            DaryHeap<int, 4> h;
+            for (auto k : keys) h.push(k);
+            while (!h.empty()) h.pop();
+        });
+
+        b.run("dary_heap_8", "random", n, 2*n, [&] {
+            DaryHeap<int, 8> h;
+            for (auto k : keys) h.push(k);
+            while (!h.empty()) h.pop();
+        });
+
+        b.run("indexed_binary_heap", "random", n, 2*n, [&] {
+            IndexedBinaryHeap<int> h((int) n);
+            for (long i=0; i<n; i++) h.insert((int) i, keys[i]);
+            while (!h.empty()) h.pop();
+        });
+
+        b.run("fibonacci_heap", "random", n, 2*n, [&] {
+            FibonacciHeap<int> h;
+            h.reserve((int) n);
+            for (long i=0; i<n; i++) h.insert(keys[i], (int) i);
+            while (h.size() > 0) h.remove_min();
+        });
+
+        b.run("pairing_heap", "random", n, 2*n, [&] {
+            PairingHeap<int> h;
+            h.reserve((int) n);
+            for (long i=0; i<n; i++) h.insert(keys[i], (int) i);
+            while (h.size() > 0) h.remove_min();
+        });
+
+        // monotone: keys are inserted as offsets from the last minimum,
+        // the way Dijkstra's algorithm uses a heap
+
+        b.run("radix_heap_monotone", "random", n, 2*n, [&] {
+            RadixHeap<int> h;
+            h.reserve((int) n);
+            for (long i=0; i<n; i++) {
+                h.insert(h.size() > 0 ? h.get_min_key() + keys[i] % 1000 : keys[i] % 1000, (int) i);
+                if (i % 2) h.remove_min();
+            }
+            while (h.size() > 0) h.remove_min();
+        });
+
+        b.run("fibonacci_heap_monotone", "random", n, 2*n, [&] {
+            FibonacciHeap<int> h;
+            h.reserve((int) n);
+            for (long i=0; i<n; i++) {
+                h.insert(h.size() > 0 ? h.get_min_key() + keys[i] % 1000 : keys[i] % 1000, (int) i);
+                if (i % 2) h.remove_min();
+            }
+            while (h.size() > 0) h.remove_min();
+        });
+
+        // heapify, m = n elements
+
+        vector<int> a;
+        b.run("heapify", "random", n, n, [&] { heapify(a); }, [&] { a = keys; });
+
+        b.run("dary_heap_4_heapify", "random", n, n, [&] {
+            DaryHeap<int, 4> h(keys.begin(), keys.end());
+        });
+
+        // decrease-key: n inserts, n decrease-keys, n extract-min
+
+        vector<int> dec(n);
+        for (long i=0; i<n; i++)
+            dec[i] = keys[i] - (int) uniform(rng, 1000);
+
+        b.run("indexed_binary_heap_decrease_key", "random", n, 3*n, [&] {
+            IndexedBinaryHeap<int> h((int) n);
+            for (long i=0; i<n; i++) h.insert((int) i, keys[i]);
+            for (long i=0; i<n; i++) h.decrease_key((int) i, dec[i]);
+            while (!h.empty()) h.pop();
+        });
+
+        b.run("pairing_heap_decrease_key", "random", n, 3*n, [&] {
+            PairingHeap<int> h;
+            h.reserve((int) n);
+            vector<PairingHeap<int>::Node *> nodes(n);
+            for (long i=0; i<n; i++) nodes[i] = h.insert(keys[i], (int) i);
+            for (long i=0; i<n; i++) h.decrease_key(nodes[i], dec[i]);
+            while (h.size() > 0) h.remove_min();
+        });
+
+        b.run("indexed_dary_heap_4_decrease_key", "random", n, 3*n, [&] {
+            IndexedDaryHeap<int, 4> h((int) n);
+            for (long i=0; i<n; i++) h.insert((int) i, keys[i]);
+            for (long i=0; i<n; i++) h.decrease_key((int) i, dec[i]);
+            while (!h.empty()) h.pop();
+        });
+
+        b.run("fibonacci_heap_decrease_key", "random", n, 3*n, [&] {
+            FibonacciHeap<int> h;
+            h.reserve((int) n);
+            vector<FibonacciHeap<int>::Node *> nodes(n);
+            for (long i=0; i<n; i++) nodes[i] = h.insert(keys[i], (int) i);
+            for (long i=0; i<n; i++) h.decrease_key(nodes[i], dec[i]);
+            while (h.size() > 0) h.remove_min();
+        });
+
+        // building one heap of n elements, one by one, in bulk or by
+        // melding 16 heaps of n/16 elements (built in setup) in pairs,
+        // m = n
+
+        const int parts {16};
+
+        vector<pair<int, int>> items(n);    // (id, key)
+        for (long i=0; i<n; i++)
+            items[i] = make_pair((int) i, keys[i]);
+
+        b.run("indexed_binary_heap_insert", "random", n, n, [&] {
+            IndexedBinaryHeap<int> h((int) n);
+            for (auto &x : items) h.insert(x.first, x.second);
+        });
+
+        b.run("indexed_binary_heap_insert_range", "random", n, n, [&] {
+            IndexedBinaryHeap<int> h((int) n);
+            h.insert_range(items.begin(), items.end());
+        });
+
+        vector<unique_ptr<IndexedBinaryHeap<int>>> ih;
+        auto partitions = [&] {
+            ih.clear();
+            for (int p=0; p<parts; p++) ih.emplace_back(new IndexedBinaryHeap<int>((int) n));
+            for (long i=0; i<n; i++) ih[i % parts]->insert((int) i, keys[i]);
+        };
+
+        b.run("indexed_binary_heap_reinsert", "random", n, n, [&] {
+            for (int p=1; p<parts; p++)
+                while (!ih[p]->empty()) {
+                    int id = ih[p]->top();
+                    ih[0]->insert(id, ih[p]->key_of(id));
+                    ih[p]->pop();
+                }
+        }, partitions);
+
+        b.run("indexed_binary_heap_meld", "random", n, n, [&] {
+            for (int step=1; step<parts; step*=2)
+                for (int p=0; p+step<parts; p+=2*step)
+                    ih[p]->meld(*ih[p+step]);
+        }, partitions);
+
+        b.run("fibonacci_heap_insert", "random", n, n, [&] {
+            FibonacciHeap<int> h;
+            for (long i=0; i<n; i++) h.insert(keys[i], (int) i);
+        });
+
+        vector<unique_ptr<FibonacciHeap<int>>> fh;
+        b.run("fibonacci_heap_meld", "random", n, n, [&] {
+            for (int p=1; p<parts; p++) fh[0]->meld(*fh[p]);
+        }, [&] {
+            fh.clear();
+            for (int p=0; p<parts; p++) fh.emplace_back(new FibonacciHeap<int>);
+            for (long i=0; i<n; i++) fh[i % parts]->insert(keys[i], (int) i);
+        });
+    }
+}
+
+
+/*
+ *  Main
+ */
+
+int main(int argc, const char * argv[]) {
+
+    string format {"csv"};
+    string filter;
+    uint64_t seed {1};
+    long scale {1};
+    int reps {3};
+
+    for (int i=1; i<argc; i++) {
+        string arg {argv[i]};
+
+        if (i+1 == argc) {
+            cerr << "missing value of " << arg << endl;
+            return 1;
+        }
+
+        if (arg == "--format") format = argv[++i];
+        else if (arg == "--seed") seed = strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--scale") scale = atol(argv[++i]);
+        else if (arg == "--reps") reps = atoi(argv[++i]);
+        else if (arg == "--filter") filter = argv[++i];
+        else {
+            cerr << "unknown option " << arg << endl;
+            return 1;
+        }
+    }
+
+    Benchmark b(reps, filter);
+
+    bench_heaps(b, scale, seed);
+    bench_disjoint_sets(b, scale, seed);
+    bench_shortest_paths(b, scale, seed);
+    bench_all_pairs(b, scale, seed);
+    bench_max_flow(b, scale, seed);
+
+    if (format == "json")
+        b.print_json(cout);
+    else
+        b.print_csv(cout);
+
+    return 0;
+}
@@ -0,0 +1,118 @@
+//
+//  graph-generators.hpp
+//
+//  Synthetic graphs for benchmarks, all of them are reproducible:
+//  the same seed gives the same edge list on every machine
+//  (mt19937_64 and integer arithmetic only, no std distributions
+//  as those differ between standard libraries).
+//
+//  Created by mkuklik on 12/1/15.
+//  Copyright © 2015 mkuklik. All rights reserved.
+//
+
+#ifndef GraphGenerators_hpp
+#define GraphGenerators_hpp
+
+#include <vector>
+#include <random>
+#include <cstdint>
+
+#include "../CSR Graph/csr-graph.hpp"
+
+typedef std::vector<CSRGraph<int>::Edge> EdgeList;
+
+/*
+ *  uniform integer in [0, n)
+ */
+
+inline uint64_t uniform(std::mt19937_64 &rng, uint64_t n) {
+    return rng() % n;
+}
+
+/*
+ *  gnm, Erdős–Rényi G(n, m): m directed edges with both ends picked
+ *      uniformly at random, weights in [1, max_w]
+ */
+
+inline EdgeList gnm(int n, long m, uint64_t seed, int max_w = 100) {
+
+    std::mt19937_64 rng(seed);
+    EdgeList edges;
+    edges.reserve(m);
+
+    for (long i=0; i<m; i++) {
+        int f = (int) uniform(rng, n);
+        int t = (int) uniform(rng, n);
+        edges.push_back(CSRGraph<int>::Edge(f, t, 1 + (int) uniform(rng, max_w)));
+    }
+
+    return edges;
+}
+
+/*
+ *  grid, rows x cols lattice, every vertex is linked both ways with
+ *      its 4 neighbours, like a road network; vertex id is r*cols + c
+ */
+
+inline EdgeList grid(int rows, int cols, uint64_t seed, int max_w = 100) {
+
+    std::mt19937_64 rng(seed);
+    EdgeList edges;
+    edges.reserve(4L * rows * cols);
+
+    for (int r=0; r<rows; r++)
+        for (int c=0; c<cols; c++) {
+            int v = r*cols + c;
+
+            if (c+1 < cols) {
+                int w = 1 + (int) uniform(rng, max_w);
+                edges.push_back(CSRGraph<int>::Edge(v, v+1, w));
+                edges.push_back(CSRGraph<int>::Edge(v+1, v, w));
+            }
+            if (r+1 < rows) {
+                int w = 1 + (int) uniform(rng, max_w);
+                edges.push_back(CSRGraph<int>::Edge(v, v+cols, w));
+                edges.push_back(CSRGraph<int>::Edge(v+cols, v, w));
+            }
+        }
+
+    return edges;
+}
+
+/*
+ *  rmat, recursive matrix graph (Chakrabarti, Zhan, Faloutsos 2004),
+ *      n = 2^scale vertices, m edges. Each edge picks one quadrant of
+ *      the adjacency matrix per bit with probabilities a, b, c, d=1-a-b-c,
+ *      giving power-law degrees. Defaults are the Graph500 ones.
+ *      Probabilities are given in 1/1000.
+ */
+
+inline EdgeList rmat(int scale, long m, uint64_t seed, int max_w = 100,
+                     int a = 570, int b = 190, int c = 190) {
+
+    std::mt19937_64 rng(seed);
+    EdgeList edges;
+    edges.reserve(m);
+
+    for (long i=0; i<m; i++) {
+        int f {0}, t {0};
+
+        for (int bit=0; bit<scale; bit++) {
+            int p = (int) uniform(rng, 1000);
+
+            f <<= 1;
+            t <<= 1;
+
+            if (p < a) {}
+            else if (p < a + b) t |= 1;
+            else if (p < a + b + c) f |= 1;
+            else { f |= 1; t |= 1; }
+        }
+
+        edges.push_back(CSRGraph<int>::Edge(f, t, 1 + (int) uniform(rng, max_w)));
+    }
+
+    return edges;
+}
+
+#endif /* GraphGenerators_hpp */
@@ -0,0 +1,382 @@
+//
+//  binary-heap.hpp
+//
+//  Created by mkuklik on 11/8/15.
+//  Copyright © 2015 mkuklik. All rights reserved.
+//
+
+#ifndef BinaryHeap_hpp
+#define BinaryHeap_hpp
+
+#include <vector>
+#include <algorithm>
+#include <functional>
+
+/*
+operation linked list binary heap
+MAKE-HEAP       O(1)    O(1)
+ISEMPTY         O(1)    O(1)
+INSERT          O(1)    O(log n)
+EXTRACT-MIN     O(n)    O(log n)
+DECREASE-KEY    O(1)    O(log n)
+DELETE          O(1)    O(log n)
+MELD            O(1)    O(n)
+FIND-MIN        O(n)    O(1)
+*/
+
+// insert
+// 1. place element at the end of the array,
+// 2. percolate up until in right place
+
+// delete minimum
+// 1. pick minimum element from the top of the heap
+// 2. replace it with the last one
+// 3. percolate it down to restore the heap
+
+// decrease key
+// 1. decrease key of the element in the tree
+// 2. percolate up
+
+// increase key
+// 1. increase the key and
+// 2. percolate down
+
+// delete any element
+// 1. decrease key to -Inf
+// 2. remove the minimum element
+
+//
+// Meld. Given two binary heaps H1 and H2, merge into a single binary heap.
+
+/* Build Max-Heap : Using MAX-HEAPIFY() we can construct a max-heap by starting with the last node that has children (which occurs at A.length/2 the elements the array A.(length/2+1) to A.n are all leaves of the tree ) and iterating back to the root calling MAX-HEAPIFY() for each node which ensures that the max-heap property will be maintained at each step for all evaluated nodes. The pseudocode for the routine is
+
+    BUILD-MAX-HEAP(A)
+        A.heapsize = A.length
+        for i = A.length/2 downto 1
+            MAX-HEAPIFY(A,i)
+*/
+
+// 0 , 1, 2 , (3, 4) , (5, 6), 7, 8
+
+//using namespace std;
+
+inline size_t parent(size_t i) { return (i - (size_t) 1) >> 1; }
+inline size_t left_child(size_t i) {return 2*i+1;}
+inline size_t right_child(size_t i) {return 2*(i+1);}
+
+/*
+ *  percolateDown, moves the node from to-down
+ *  until the heap properties are restored
+ *
+ *  used when adding new element
+ */
+
+template<typename T>
+void percolateDown(std::vector<T> &a, size_t i) {
+    
+    auto s = a.size();
+    size_t left {left_child(i)};
+    size_t right {right_child(i)};
+    
+    size_t top {i};
+    
+    if (left < s && a[top] < a[left])
+        top = left;
+    
+    if (right < s && a[top] < a[right])
+        top = right;
+    
+    if (top != i) {
+        std::swap(a[top], a[i]);
+        percolateDown(a, top);
+    }
+    
+}
+
+/*
+ *  percolateUp, moves the node from bottom-up
+ *  until the heap properties are restored
+ *
+ *  used when adding new element
+ */
+
+template<typename T>
+void percolateUp(std::vector<T> &a, size_t i) {
+    
+    if (i == 0) return;
+    
+    for (; i != 0;) {
+        
+        size_t j = parent(i);
+        
+        if (a[j] > a[i]) break;
+        
+        std::swap(a[j], a[i]);
+
+        i = j;
+    }
+}
+
+/*
+ *  create heap in the vector a, in place;
+ */
+
+template<class T>
+void heapify(std::vector<T> &a) {
+    
+    size_t s = a.size();
+    
+    if (s < 2) return;
+    
+    for (size_t i = parent(s-1) + 1; i != 0; ) {
+        percolateDown(a, --i);
+    }
+    
+}
+
+/*
+ *  meld, moves all elements of b to the heap a, O(n + m): the arrays
+ *  are concatenated and the heap is built again with heapify
+ */
+
+template<class T>
+void meld(std::vector<T> &a, std::vector<T> &b) {
+    
+    a.insert(a.end(), b.begin(), b.end());
+    b.clear();
+    
+    heapify(a);
+}
+
+/*
+ *  IndexedBinaryHeap, min-heap over integer ids 0..n-1 with keys of type K
+ *
+ *  heap stores ids, pos maps an id to its index in heap (npos if the id
+ *  is not in the heap), key stores current key of each id. Keeping pos
+ *  up to date on every swap is what makes decrease_key O(log n): the
+ *  element is found in O(1) and percolated up, instead of re-heapifying
+ *  the whole array.
+ *
+ *  percolateUp/percolateDown follow the functions above, but compare
+ *  keys of ids (min-heap by default) and update pos while swapping.
+ */
+
+template<typename K, typename Compare = std::less<K>>
+class IndexedBinaryHeap {
+    
+    std::vector<int> heap;      // ids in heap order
+    std::vector<size_t> pos;    // id -> index in heap
+    std::vector<K> key;         // id -> key
+    Compare comp;
+    
+    bool before(size_t i, size_t j) const { return comp(key[heap[i]], key[heap[j]]); }
+    
+    void swap_nodes(size_t i, size_t j) {
+        std::swap(heap[i], heap[j]);
+        pos[heap[i]] = i;
+        pos[heap[j]] = j;
+    }
+    
+    void percolateUp(size_t i) {
+        
+        for (; i != 0;) {
+            
+            size_t j = parent(i);
+            
+            if (!before(i, j)) break;
+            
+            swap_nodes(i, j);
+            
+            i = j;
+        }
+    }
+    
+    void percolateDown(size_t i) {
+        
+        auto s = heap.size();
+        
+        while (true) {
+            
+            size_t left {left_child(i)};
+            size_t right {right_child(i)};
+            
+            size_t top {i};
+            
+            if (left < s && before(left, top))
+                top = left;
+            
+            if (right < s && before(right, top))
+                top = right;
+            
+            if (top == i) break;
+            
+            swap_nodes(top, i);
+            i = top;
+        }
+    }
+    
+    /*
+     *  restore, heap[0..from) is a heap, the k elements from `from` on
+     *      were appended; either every new one percolates up,
+     *      O(k log n), or the whole heap is built again bottom up, O(n),
+     *      whichever is cheaper
+     */
+    
+    void restore(size_t from) {
+        
+        size_t s = heap.size();
+        
+        size_t levels {0};
+        for (size_t x = s; x > 1; x >>= 1) ++levels;
+        
+        if ((s - from) * levels > s) {
+            if (s > 1)
+                for (size_t i = parent(s-1) + 1; i != 0; )
+                    percolateDown(--i);
+        }
+        else
+            for (size_t i = from; i < s; i++)
+                percolateUp(i);
+    }
+    
+public:
+    
+    enum : size_t { npos = (size_t) -1 };   // marks ids not in the heap
+    
+    IndexedBinaryHeap(int n, Compare c = Compare()): pos(n, npos), key(n), comp(c) {
+        heap.reserve(n);
+    };
+    
+    bool empty() const { return heap.empty(); }
+    
+    size_t size() const { return heap.size(); }
+    
+    bool contains(int id) const { return pos[id] != npos; }
+    
+    const K & key_of(int id) const { return key[id]; }
+    
+    /*
+     *  top, id with the lowest key
+     */
+    
+    int top() const {
+        if (heap.empty()) throw "heap is empty";
+        return heap[0];
+    }
+    
+    /*
+     *  insert id with key k, id must not be in the heap
+     */
+    
+    void insert(int id, const K &k) {
+        if (contains(id)) throw "id is already in the heap";
+        
+        key[id] = k;
+        pos[id] = heap.size();
+        heap.push_back(id);
+        percolateUp(heap.size() - 1);
+    }
+    
+    /*
+     *  pop, remove id with the lowest key and return it
+     */
+    
+    int pop() {
+        if (heap.empty()) throw "heap is empty";
+        
+        int id = heap[0];
+        swap_nodes(0, heap.size() - 1);
+        heap.pop_back();
+        pos[id] = npos;
+        
+        if (!heap.empty())
+            percolateDown(0);
+        
+        return id;
+    }
+    
+    /*
+     *  decrease_key, id must be in the heap and k must not be worse than current key
+     */
+    
+    void decrease_key(int id, const K &k) {
+        if (!contains(id)) throw "id is not in the heap";
+        if (comp(key[id], k)) throw "new key is greater than current key";
+        
+        key[id] = k;
+        percolateUp(pos[id]);
+    }
+    
+    /*
+     *  insert_or_decrease, inserts id or decreases its key if already present
+     */
+    
+    void insert_or_decrease(int id, const K &k) {
+        if (contains(id))
+            decrease_key(id, k);
+        else
+            insert(id, k);
+    }
+    
+    /*
+     *  insert_range, inserts (id, key) pairs of [first, last), ids must
+     *      not be in the heap
+     */
+    
+    template<typename It>
+    void insert_range(It first, It last) {
+        
+        size_t from = heap.size();
+        bool duplicate {false};
+        
+        for (; first != last; ++first) {
+            
+            int id = first->first;
+            
+            if (contains(id)) {
+                duplicate = true;
+                break;
+            }
+            
+            key[id] = first->second;
+            pos[id] = heap.size();
+            heap.push_back(id);
+        }
+        
+        restore(from);
+        
+        if (duplicate) throw "id is already in the heap";
+    }
+    
+    /*
+     *  meld, moves all ids of other, a heap over the same ids, to this
+     *      heap; no id can be in both. O(n + m)
+     */
+    
+    void meld(IndexedBinaryHeap &other) {
+        
+        if (&other == this) return;
+        
+        for (auto id : other.heap)
+            if (contains(id)) throw "id is already in the heap";
+        
+        size_t from = heap.size();
+        
+        for (auto id : other.heap) {
+            key[id] = other.key[id];
+            pos[id] = heap.size();
+            heap.push_back(id);
+        }
+        
+        other.clear();
+        
+        restore(from);
+    }
+    
+    void clear() {
+        for (auto id : heap) pos[id] = npos;
+        heap.clear();
+    }
+};
+
+#endif /* BinaryHeap_hpp */
@@ -0,0 +1,75 @@
+//
+//  csr-file.cpp
+//
+//  Saves a graph in the binary CSR format, maps it back and runs
+//  Dijkstra's algorithm on the mapped graph, see csr-file.hpp
+//
+//  Created by mkuklik on 12/3/15.
+//  Copyright © 2015 mkuklik. All rights reserved.
+//
+
+#include <iostream>
+#include <vector>
+
+#include "csr-file.hpp"
+#include "../Shortest Paths/Dijkstras stdlib heap/dijkstras-stdlib-heap.hpp"
+#include "../Maximum Flow/max-flow.hpp"
+
+using namespace std;
+
+
+int main(int argc, const char * argv[]) {
+
+    string path = argc > 1 ? argv[1] : "graph.csr";
+
+    CSRGraph<int>::Builder b(9);
+    b.add(0,1,4);
+    b.add(0,7,8);
+    b.add(1,2,8);
+    b.add(2,3,7);
+    b.add(2,5,4);
+    b.add(2,8,2);
+    b.add(7,8,7);
+    b.add(7,1,11);
+    b.add(7,6,1);
+    b.add(6,5,2);
+    b.add(6,8,6);
+    b.add(5,3,14);
+    b.add(5,4,10);
+    b.add(3,4,9);
+
+    try {
+        write_csr(path, b.build());
+
+        MappedCSRGraph<int> m(path);
+        const CSRGraph<int> &g = m.graph();
+
+        g.print();
+
+        vector<int> dist, previous;
+        dijkstras_binary_heap(g, 0, dist, previous);
+
+        cout << "distances from 0:";
+        for (int v=0; v<g.n_vertices(); v++)
+            cout << " " << dist[v];
+        cout << endl;
+
+        // residual graph, flow from 0 to 4
+        CSRGraph<int> h = b.build();
+        vector<CSRGraph<int>::Edge> edges;
+        for (int v=0; v<h.n_vertices(); v++)
+            for (int i=h.offset[v]; i<h.offset[v+1]; i++)
+                edges.push_back(CSRGraph<int>::Edge(v, h.target[i], h.value[i]));
+
+        write_csr(path, CSRResidualGraph<int>(h.n_vertices(), edges));
+
+        MappedCSRResidualGraph<int> r(path);
+        cout << "max flow from 0 to 4: " << max_flow(r.graph(), 0, 4) << endl;
+    }
+    catch (const char * e) {
+        cerr << e << endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,379 @@
+//
+//  csr-file.hpp
+//
+//  Binary file format for CSR graphs, writer and memory mapped reader
+//
+//  Created by mkuklik on 12/3/15.
+//  Copyright © 2015 mkuklik. All rights reserved.
+//
+
+/*
+ *  The file is a header followed by the arrays of the graph exactly as
+ *  they are in memory, each one starting at a multiple of 64 bytes.
+ *  The reader maps the file with mmap and the graph arrays are views
+ *  of the mapping (CSRArray::view), so loading doesn't parse or copy
+ *  anything; pages are read by the OS when the algorithm touches them.
+ *
+ *  Layout, version 1
+ *
+ *      CSRFileHeader                   (64 bytes)
+ *      CSRGraph:           offset[N+1], target[M], value[M]
+ *      CSRResidualGraph:   offset[N+1], target[M], twin[M], capacity[M],
+ *                          edge[M], arc[E]
+ *      ContractionHierarchy: rank[N], upward and downward CSRGraph,
+ *                          see contraction-hierarchy.hpp
+ *
+ *  M is the number of arcs, E the number of original edges of a
+ *  residual graph (M = 2E). Vertex and arc ids are 32-bit ints, so a
+ *  graph can have up to 2^31 - 1 arcs.
+ *
+ *  Arrays are stored in the byte order of the machine that wrote them;
+ *  the header has a byte order mark and the reader refuses files
+ *  written with the other one. The format is versioned, readers
+ *  reject unknown versions.
+ */
+
+#ifndef CSRFile_hpp
+#define CSRFile_hpp
+
+#include <cstdio>
+#include <cstdint>
+#include <climits>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "csr-graph.hpp"
+
+enum CSRFileKind : uint32_t { CSR_GRAPH = 1, CSR_RESIDUAL_GRAPH = 2, CSR_CONTRACTION_HIERARCHY = 3 };
+
+struct CSRFileHeader {
+    char magic[8];              // "CSRGRAPH"
+    uint32_t version;           // CSR_FILE_VERSION
+    uint32_t byte_order;        // 0x01020304 as written
+    uint32_t kind;              // CSRFileKind
+    uint32_t value_size;        // sizeof(T) of value/capacity
+    uint64_t n_vertices;
+    uint64_t n_arcs;
+    uint64_t n_edges;           // original edges of a residual graph, n_arcs otherwise
+    uint8_t reserved[16];
+};
+
+static_assert(sizeof(CSRFileHeader) == 64, "CSRFileHeader must be 64 bytes");
+
+const uint32_t CSR_FILE_VERSION = 1;
+const uint32_t CSR_BYTE_ORDER = 0x01020304;
+const size_t CSR_ALIGN = 64;
+
+
+/*
+ *  CSRFileWriter, writes the arrays one after another with padding
+ */
+
+class CSRFileWriter {
+
+    FILE * f;
+    size_t pos {0};
+
+    void write(const void * data, size_t bytes) {
+        if (bytes > 0 && fwrite(data, 1, bytes, f) != bytes)
+            throw "csr file: write failed";
+        pos += bytes;
+    }
+
+public:
+
+    CSRFileWriter(const std::string &path, const CSRFileHeader &h) {
+        f = fopen(path.c_str(), "wb");
+        if (f == nullptr) throw "csr file: can't open file for writing";
+        write(&h, sizeof(h));
+    }
+
+    ~CSRFileWriter() {
+        if (f != nullptr) fclose(f);
+    }
+
+    template<typename A>
+    void array(const A &a) {
+        static const char zeros[CSR_ALIGN] = {0};
+        write(zeros, (CSR_ALIGN - pos % CSR_ALIGN) % CSR_ALIGN);
+        write(a.data(), a.size() * sizeof(a[0]));
+    }
+
+    void close() {
+        if (fclose(f) != 0) throw "csr file: close failed";
+        f = nullptr;
+    }
+};
+
+template<typename T>
+CSRFileHeader csr_file_header(CSRFileKind kind, uint64_t n, uint64_t m, uint64_t e) {
+    CSRFileHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, "CSRGRAPH", 8);
+    h.version = CSR_FILE_VERSION;
+    h.byte_order = CSR_BYTE_ORDER;
+    h.kind = kind;
+    h.value_size = sizeof(T);
+    h.n_vertices = n;
+    h.n_arcs = m;
+    h.n_edges = e;
+    return h;
+}
+
+/*
+ *  write_csr, save graph to a file
+ */
+
+template<typename T>
+void write_csr(const std::string &path, const CSRGraph<T> &g) {
+
+    CSRFileWriter w(path, csr_file_header<T>(CSR_GRAPH, g.N, g.target.size(), g.target.size()));
+    w.array(g.offset);
+    w.array(g.target);
+    w.array(g.value);
+    w.close();
+}
+
+template<typename T>
+void write_csr(const std::string &path, const CSRResidualGraph<T> &g) {
+
+    CSRFileWriter w(path, csr_file_header<T>(CSR_RESIDUAL_GRAPH, g.N, g.target.size(), g.arc.size()));
+    w.array(g.offset);
+    w.array(g.target);
+    w.array(g.twin);
+    w.array(g.capacity);
+    w.array(g.edge);
+    w.array(g.arc);
+    w.close();
+}
+
+
+/*
+ *  MappedFile, read-only memory mapping of a whole file
+ */
+
+class MappedFile {
+
+    void * p {nullptr};
+    size_t n {0};
+
+public:
+
+    MappedFile(const std::string &path, bool populate = false) {
+
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw "mapped file: can't open file";
+
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw "mapped file: can't stat file";
+        }
+
+        n = (size_t) st.st_size;
+
+        if (n > 0) {
+            int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+            if (populate) flags |= MAP_POPULATE;    // read all pages now
+#endif
+            p = mmap(nullptr, n, PROT_READ, flags, fd, 0);
+        }
+
+        ::close(fd);    // mapping stays valid
+
+        if (p == MAP_FAILED) {
+            p = nullptr;
+            throw "mapped file: mmap failed";
+        }
+    }
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile & operator=(const MappedFile &) = delete;
+
+    ~MappedFile() {
+        if (p != nullptr) munmap(p, n);
+    }
+
+    const char * data() const { return (const char *) p; }
+
+    size_t size() const { return n; }
+
+    /*
+     *  sequential, hint that the file will be read front to back
+     */
+
+    void sequential() const {
+        if (p != nullptr) madvise(p, n, MADV_SEQUENTIAL);
+    }
+};
+
+
+/*
+ *  CSRFileReader, checks the header and hands out views of the arrays
+ *      in the order they were written
+ */
+
+class CSRFileReader {
+
+    const MappedFile &file;
+    size_t pos {sizeof(CSRFileHeader)};
+
+public:
+
+    CSRFileHeader header;
+
+    CSRFileReader(const MappedFile &f, CSRFileKind kind, uint32_t value_size): file(f) {
+
+        if (file.size() < sizeof(CSRFileHeader)) throw "csr file: file too short";
+
+        memcpy(&header, file.data(), sizeof(header));
+
+        if (memcmp(header.magic, "CSRGRAPH", 8) != 0) throw "csr file: not a CSR graph file";
+        if (header.version != CSR_FILE_VERSION) throw "csr file: unsupported version";
+        if (header.byte_order != CSR_BYTE_ORDER) throw "csr file: wrong byte order";
+        if (header.kind != kind) throw "csr file: wrong kind of graph";
+        if (header.value_size != value_size) throw "csr file: wrong value type";
+
+        // ids are ints, and n + 1 offsets must be countable
+        if (header.n_vertices > INT_MAX || header.n_arcs > INT_MAX || header.n_edges > INT_MAX)
+            throw "csr file: graph too big";
+    }
+
+    template<typename A>
+    A array(size_t count) {
+
+        typedef typename std::remove_reference<decltype(A()[0])>::type E;
+
+        pos += (CSR_ALIGN - pos % CSR_ALIGN) % CSR_ALIGN;
+
+        // no overflow: count and pos are checked against what's left
+        if (pos > file.size() || count > (file.size() - pos) / sizeof(E))
+            throw "csr file: file too short";
+
+        size_t bytes = count * sizeof(E);
+
+        A a = A::view((const E *) (file.data() + pos), count);
+        pos += bytes;
+        return a;
+    }
+};
+
+
+/*
+ *  valid_offsets, offset[0] = 0, never going down and offset[n] = m,
+ *      O(n); valid_ids, all of a in [0, limit), O(size of a)
+ */
+
+inline bool valid_offsets(const CSRArray<int> &offset, size_t n, size_t m) {
+
+    if (offset.size() != n + 1 || offset[0] != 0 || (size_t) offset[n] != m) return false;
+
+    for (size_t i=0; i<n; i++)
+        if (offset[i] > offset[i+1]) return false;
+
+    return true;
+}
+
+inline bool valid_ids(const CSRArray<int> &a, size_t limit) {
+
+    for (auto x : a)
+        if (x < 0 || (size_t) x >= limit) return false;
+
+    return true;
+}
+
+
+/*
+ *  MappedCSRGraph, graph which arrays are views of a mapped file;
+ *      the file stays mapped as long as the object lives. offset[0] and
+ *      offset[N] are always checked; validate checks all offsets, O(N),
+ *      and targets, O(M), so a corrupt file can't make algorithms read
+ *      out of bounds
+ */
+
+template<typename T>
+class MappedCSRGraph {
+
+    MappedFile file;
+    CSRGraph<T> g;
+
+public:
+
+    MappedCSRGraph(const std::string &path, bool populate = false, bool validate = false):
+        file(path, populate) {
+
+        CSRFileReader r(file, CSR_GRAPH, sizeof(T));
+
+        size_t n = r.header.n_vertices;
+        size_t m = r.header.n_arcs;
+
+        g.N = (int) n;
+        g.offset = r.array<CSRArray<int>>(n + 1);
+        g.target = r.array<CSRArray<int>>(m);
+        g.value = r.array<CSRArray<T>>(m);
+
+        if (g.offset[0] != 0 || (size_t) g.offset[n] != m) throw "csr file: corrupt offsets";
+
+        if (validate) {
+            if (!valid_offsets(g.offset, n, m)) throw "csr file: corrupt offsets";
+            if (!valid_ids(g.target, n)) throw "csr file: corrupt targets";
+        }
+    }
+
+    const CSRGraph<T> & graph() const { return g; }
+};
+
+/*
+ *  MappedCSRResidualGraph, the same for residual graphs; only residual
+ *      capacities are allocated (resid), as max-flow algorithms change them.
+ *      validate also checks twin and arc ids.
+ */
+
+template<typename T>
+class MappedCSRResidualGraph {
+
+    MappedFile file;
+    CSRResidualGraph<T> g;
+
+public:
+
+    MappedCSRResidualGraph(const std::string &path, bool populate = false, bool validate = false):
+        file(path, populate) {
+
+        CSRFileReader r(file, CSR_RESIDUAL_GRAPH, sizeof(T));
+
+        size_t n = r.header.n_vertices;
+        size_t m = r.header.n_arcs;
+        size_t e = r.header.n_edges;
+
+        g.N = (int) n;
+        g.offset = r.array<CSRArray<int>>(n + 1);
+        g.target = r.array<CSRArray<int>>(m);
+        g.twin = r.array<CSRArray<int>>(m);
+        g.capacity = r.array<CSRArray<T>>(m);
+        g.edge = r.array<CSRArray<int>>(m);
+        g.arc = r.array<CSRArray<int>>(e);
+
+        if (g.offset[0] != 0 || (size_t) g.offset[n] != m) throw "csr file: corrupt offsets";
+
+        if (validate) {
+            if (!valid_offsets(g.offset, n, m)) throw "csr file: corrupt offsets";
+            if (!valid_ids(g.target, n) || !valid_ids(g.twin, m) || !valid_ids(g.arc, m))
+                throw "csr file: corrupt arcs";
+        }
+
+        g.reset();
+    }
+
+    CSRResidualGraph<T> & graph() { return g; }
+};
+
+#endif /* CSRFile_hpp */
@@ -0,0 +1,314 @@
+//
+//  csr-graph.hpp
+//
+//  Compressed sparse row (CSR) graph shared by the shortest path
+//  and maximum flow algorithms.
+//
+//  Created by mkuklik on 11/20/15.
+//  Copyright © 2015 mkuklik. All rights reserved.
+//
+
+/*
+ *  Graphs in the other directories keep adjacency as linked lists of
+ *  edges, one allocation per edge, and add() walks to the end of the
+ *  list. In CSR form all edges are kept in contiguous arrays sorted by
+ *  the source vertex:
+ *
+ *      out-edges of v are at indices [offset[v], offset[v+1])
+ *      target[i]   end vertex of edge i
+ *      value[i]    weight (or capacity) of edge i
+ *
+ *  e.g. edges 0->1, 0->2, 2->1 with N=3 give
+ *
+ *      offset  0 2 2 3
+ *      target  1 2 1
+ *
+ *  The graph is static, it's built once from an edge list with counting
+ *  sort on the source vertex, O(V+E). Sort is stable so out-edges of
+ *  a vertex keep the order in which they were added, which is the same
+ *  order the linked-list graphs iterate in.
+ */
+
+#ifndef CSRGraph_hpp
+#define CSRGraph_hpp
+
+#include <iostream>
+#include <vector>
+#include <utility>
+
+
+/*
+ *  CSRArray, array of a CSR graph. Either owns its elements (like
+ *  std::vector) or is a view of memory owned by someone else, e.g. a
+ *  memory mapped file (csr-file.hpp), so algorithms can run on it
+ *  without copying. Views are read-only by contract.
+ */
+
+template<typename T>
+class CSRArray {
+
+    std::vector<T> own;
+    T * p {nullptr};
+    size_t n {0};
+    bool is_view {false};
+
+public:
+
+    CSRArray() {};
+
+    CSRArray(size_t size, const T &v = T()): own(size, v), p(own.data()), n(size) {};
+
+    CSRArray(const CSRArray &a): own(a.own), p(a.is_view ? a.p : own.data()), n(a.n),
+                                 is_view(a.is_view) {};
+
+    CSRArray(CSRArray &&a): own(std::move(a.own)), p(a.is_view ? a.p : own.data()), n(a.n),
+                            is_view(a.is_view) {
+        a.p = nullptr;
+        a.n = 0;
+    };
+
+    CSRArray & operator=(CSRArray a) {
+        own.swap(a.own);
+        p = a.is_view ? a.p : own.data();
+        n = a.n;
+        is_view = a.is_view;
+        return *this;
+    }
+
+    /*
+     *  view of size elements at data
+     */
+
+    static CSRArray view(const T * data, size_t size) {
+        CSRArray a;
+        a.p = const_cast<T *>(data);
+        a.n = size;
+        a.is_view = true;
+        return a;
+    }
+
+    void resize(size_t size, const T &v = T()) {
+        if (is_view) throw "CSRArray: view can't be resized";
+        own.resize(size, v);
+        p = own.data();
+        n = size;
+    }
+
+    bool view() const { return is_view; }
+
+    size_t size() const { return n; }
+
+    T & operator[](size_t i) { return p[i]; }
+    const T & operator[](size_t i) const { return p[i]; }
+
+    T * begin() { return p; }
+    T * end() { return p + n; }
+    const T * begin() const { return p; }
+    const T * end() const { return p + n; }
+
+    const T * data() const { return p; }
+};
+
+
+template<typename T>
+struct CSRGraph {
+
+    struct Edge {
+        int from;
+        int to;
+        T value;
+
+        Edge(int f, int t, T v): from(f), to(t), value(v) {};
+    };
+
+    int N {0};                  // number of vertices
+
+    CSRArray<int> offset;       // N+1 entries
+    CSRArray<int> target;
+    CSRArray<T> value;
+
+    CSRGraph(int n=0): N(n), offset(n+1, 0) {};
+
+    /*
+     *  build graph from a list of edges, counting sort by source vertex
+     */
+
+    CSRGraph(int n, const std::vector<Edge> &edges): N(n), offset(n+1, 0),
+                    target(edges.size()), value(edges.size()) {
+
+        for (auto &e : edges)
+            ++offset[e.from + 1];
+
+        for (int i=0; i<N; i++)
+            offset[i+1] += offset[i];
+
+        std::vector<int> next(offset.begin(), offset.end() - 1);
+
+        for (auto &e : edges) {
+            int i = next[e.from]++;
+            target[i] = e.to;
+            value[i] = e.value;
+        }
+    }
+
+    int n_vertices() const { return N; };
+
+    int n_edges() const { return (int) target.size(); }
+
+    int degree(int v) const { return offset[v+1] - offset[v]; }
+
+    /*
+     *  reverse, graph with all edges reversed
+     */
+
+    CSRGraph reverse() const {
+
+        std::vector<Edge> edges;
+        edges.reserve(target.size());
+
+        for (int v=0; v<N; v++)
+            for (int i=offset[v]; i<offset[v+1]; i++)
+                edges.push_back(Edge(target[i], v, value[i]));
+
+        return CSRGraph(N, edges);
+    }
+
+    /*
+     *  print
+     */
+
+    void print() const {
+        for (int v=0; v < N; v++) {
+            std::cout << v << ": ";
+
+            for (int i=offset[v]; i<offset[v+1]; i++)
+                std::cout << target[i] << "(" << value[i] << ") ";
+
+            std::cout << std::endl;
+        }
+    }
+
+    /*
+     *  Builder collects edges one at a time and sorts them once in build()
+     */
+
+    class Builder {
+        int n;
+        std::vector<Edge> edges;
+
+    public:
+        Builder(int nv, size_t m=0): n(nv) { edges.reserve(m); };
+
+        void add(int from, int to, T v) { edges.push_back(Edge(from, to, v)); }
+
+        CSRGraph build() const { return CSRGraph(n, edges); }
+    };
+};
+
+
+/*
+ *  CSRResidualGraph, residual network for maximum flow in CSR layout
+ *
+ *  Every original edge (u, v, c) is stored as two arcs, a forward arc
+ *  u->v and a reverse arc v->u, the same way edmonds-karp.cpp Graph
+ *  stores original and reverse Edge. Arcs of edge e are added as
+ *  (forward, reverse) in the order the edges were inserted, so after
+ *  the stable sort arcs of a vertex have the same order as in the
+ *  linked-list Graph.
+ *
+ *      twin[a]     index of the paired arc
+ *      capacity[a] capacity of the edge, 0 for reverse arcs
+ *      resid[a]    residual capacity, capacity - flow for forward arcs
+ *                  and flow for reverse arcs
+ *      edge[a]     id of original edge for forward arcs, -1 for reverse
+ *      arc[e]      forward arc of original edge e
+ */
+
+template<typename T>
+struct CSRResidualGraph {
+
+    typedef typename CSRGraph<T>::Edge Edge;
+
+    int N {0};
+
+    CSRArray<int> offset;
+    CSRArray<int> target;
+    CSRArray<int> twin;
+    CSRArray<T> capacity;
+    std::vector<T> resid;       // always owned, it's what algorithms change
+    CSRArray<int> edge;
+    CSRArray<int> arc;
+
+    CSRResidualGraph(int n=0): N(n), offset(n+1, 0) {};
+
+    CSRResidualGraph(int n, const std::vector<Edge> &edges): N(n), offset(n+1, 0) {
+
+        size_t m = edges.size();
+
+        target.resize(2*m);
+        twin.resize(2*m);
+        capacity.resize(2*m);
+        edge.resize(2*m);
+        arc.resize(m);
+
+        for (auto &e : edges) {
+            ++offset[e.from + 1];
+            ++offset[e.to + 1];
+        }
+
+        for (int i=0; i<N; i++)
+            offset[i+1] += offset[i];
+
+        std::vector<int> next(offset.begin(), offset.end() - 1);
+
+        for (size_t k=0; k<m; k++) {
+            const Edge &e = edges[k];
+
+            int f = next[e.from]++;     // forward arc
+            int r = next[e.to]++;       // reverse arc
+
+            target[f] = e.to;
+            capacity[f] = e.value;
+            edge[f] = (int) k;
+            twin[f] = r;
+
+            target[r] = e.from;
+            capacity[r] = 0;
+            edge[r] = -1;
+            twin[r] = f;
+
+            arc[k] = f;
+        }
+
+        reset();
+    }
+
+    int n_vertices() const { return N; };
+
+    int n_edges() const { return (int) arc.size(); }
+
+    bool is_reverse(int a) const { return edge[a] == -1; }
+
+    /*
+     *  flow on the original edge e
+     */
+
+    T flow(int e) const { return capacity[arc[e]] - resid[arc[e]]; }
+
+    /*
+     *  push f units of flow along arc a (forward or reverse)
+     */
+
+    void push(int a, T f) {
+        resid[a] -= f;
+        resid[twin[a]] += f;
+    }
+
+    /*
+     *  set all flows to zero
+     */
+
+    void reset() { resid.assign(capacity.begin(), capacity.end()); }
+};
+
+#endif /* CSRGraph_hpp */
@@ -0,0 +1,67 @@
+//
+//  graph-loader.cpp
+//
+//  Loads a DIMACS or edge list file and reports the parse speed, then
+//  runs Dijkstra's algorithm (sp and edge lists) or maximum flow (max)
+//  on it, see graph-loader.hpp
+//
+//  usage: graph-loader FILE [threads]
+//
+//  Created by mkuklik on 12/4/15.
+//  Copyright © 2015 mkuklik. All rights reserved.
+//
+
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+
+#include "graph-loader.hpp"
+#include "../Shortest Paths/Dijkstras stdlib heap/dijkstras-stdlib-heap.hpp"
+#include "../Maximum Flow/max-flow.hpp"
+
+using namespace std;
+
+
+int main(int argc, const char * argv[]) {
+
+    if (argc < 2) {
+        cerr << "usage: graph-loader FILE [threads]" << endl;
+        return 1;
+    }
+
+    int n_threads = argc > 2 ? atoi(argv[2]) : 0;
+
+    try {
+        auto t0 = chrono::steady_clock::now();
+        GraphFile f = load_graph(argv[1], FORMAT_AUTO, n_threads);
+        auto t1 = chrono::steady_clock::now();
+
+        double s = chrono::duration<double>(t1 - t0).count();
+        double mb = MappedFile(argv[1]).size() / 1e6;
+
+        cout << "vertices " << f.N << ", edges " << f.edges.size() << endl;
+        cout << "loaded in " << s << "s, " << mb / s << " MB/s" << endl;
+
+        if (f.problem == "max") {
+            CSRResidualGraph<int> g = f.residual();
+            cout << "max flow from " << f.source << " to " << f.sink << " is " <<
+                    max_flow(g, f.source, f.sink) << endl;
+        }
+        else if (f.N > 0) {
+            vector<int> dist, previous;
+            dijkstras_binary_heap(f.csr(), 0, dist, previous);
+
+            long reached {0};
+            for (auto d : dist) reached += d != INT_MAX;
+
+            cout << "vertices reachable from 0: " << reached << endl;
+        }
+    }
+    catch (const char * e) {
+        cerr << e << endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,355 @@
+//
+//  graph-loader.hpp
+//
+//  Loader of graphs from text files, DIMACS shortest path (.gr) and
+//  maximum flow (.max) formats and plain edge lists
+//
+//  Created by mkuklik on 12/4/15.
+//  Copyright © 2015 mkuklik. All rights reserved.
+//
+
+/*
+ *  DIMACS (.gr, .max), vertices are numbered from 1
+ *
+ *      c comment
+ *      p sp N M            or  p max N M
+ *      n ID s              source of .max, required for p max
+ *      n ID t              sink of .max, required for p max
+ *      a U V W             arc U->V with weight (capacity) W
+ *
+ *  Edge list, vertices are numbered from 0, weight is optional (1)
+ *
+ *      # comment           (or % comment)
+ *      U V W
+ *
+ *  The file is memory mapped and split into n_threads chunks at line
+ *  boundaries, every thread parses its chunk to its own edge list and
+ *  chunks are joined in file order, so edges are in the same order as
+ *  in the file whatever the number of threads. Numbers are parsed by
+ *  hand, there's no iostream or strtol in the inner loop.
+ *
+ *  The loaded GraphFile gives the CSR graphs directly, csr() and
+ *  residual(); the linked-list Graphs are filled from edges, e.g.
+ *
+ *      for (auto &e : f.edges) g.add(e.from, e.to, e.value);
+ */
+
+#ifndef GraphLoader_hpp
+#define GraphLoader_hpp
+
+#include <climits>
+#include <string>
+#include <vector>
+#include <thread>
+#include <algorithm>
+
+#include "csr-graph.hpp"
+#include "csr-file.hpp"
+
+enum GraphFormat { FORMAT_AUTO, DIMACS, EDGE_LIST };
+
+struct GraphFile {
+
+    typedef CSRGraph<int>::Edge Edge;
+
+    int N {0};                  // number of vertices
+    int source {-1};            // n ID s line of .max, 0-based
+    int sink {-1};              // n ID t line of .max, 0-based
+    std::string problem;        // sp, max, ... from the p line
+
+    std::vector<Edge> edges;    // 0-based
+
+    CSRGraph<int> csr() const { return CSRGraph<int>(N, edges); }
+
+    CSRResidualGraph<int> residual() const { return CSRResidualGraph<int>(N, edges); }
+};
+
+
+namespace graph_loader {
+
+    /*
+     *  Chunk, what one thread found in its part of the file
+     */
+
+    struct Chunk {
+        std::vector<GraphFile::Edge> edges;
+        long n {-1};
+        long m {-1};
+        long source {-1};
+        long sink {-1};
+        long max_id {-1};
+        std::string problem;
+        const char * error {nullptr};
+    };
+
+    inline bool blank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+    /*
+     *  number, parses optional minus and digits at p and moves p past it
+     */
+
+    inline bool number(const char * &p, const char * end, long &x) {
+
+        while (p < end && blank(*p)) ++p;
+
+        bool neg {false};
+        if (p < end && *p == '-') {
+            neg = true;
+            ++p;
+        }
+
+        if (p == end || (unsigned) (*p - '0') > 9) return false;
+
+        long v {0};
+        while (p < end && (unsigned) (*p - '0') <= 9) {
+            v = 10*v + (*p++ - '0');
+            if (v > INT_MAX) return false;
+        }
+
+        x = neg ? -v : v;
+        return true;
+    }
+
+    /*
+     *  rest_blank, nothing but blanks from p to end
+     */
+
+    inline bool rest_blank(const char * p, const char * end) {
+        while (p < end && blank(*p)) ++p;
+        return p == end;
+    }
+
+    inline bool in_int(long x) { return x >= INT_MIN && x <= INT_MAX; }
+
+    inline std::string word(const char * &p, const char * end) {
+
+        while (p < end && blank(*p)) ++p;
+
+        const char * b = p;
+        while (p < end && !blank(*p) && *p != '\n') ++p;
+
+        return std::string(b, p);
+    }
+
+    /*
+     *  parse lines in [p, end) to chunk c
+     */
+
+    inline void parse_dimacs(const char * p, const char * end, Chunk &c) {
+
+        while (p < end) {
+
+            const char * eol = std::find(p, end, '\n');
+            long u, v, w;
+
+            switch (*p) {
+                case 'a':
+                    ++p;
+                    if (!number(p, eol, u) || !number(p, eol, v) || !number(p, eol, w) ||
+                        !rest_blank(p, eol) || u < 1 || v < 1 ||
+                        !in_int(u) || !in_int(v) || !in_int(w)) {
+                        c.error = "graph loader: bad arc line";
+                        return;
+                    }
+                    c.edges.push_back(GraphFile::Edge((int) u - 1, (int) v - 1, (int) w));
+                    c.max_id = std::max(c.max_id, std::max(u, v));
+                    break;
+
+                case 'p':
+                    ++p;
+                    c.problem = word(p, eol);
+                    if (!number(p, eol, c.n) || !number(p, eol, c.m)) {
+                        c.error = "graph loader: bad problem line";
+                        return;
+                    }
+                    break;
+
+                case 'n': {
+                    ++p;
+                    if (!number(p, eol, u) || u < 1) {
+                        c.error = "graph loader: bad node line";
+                        return;
+                    }
+                    std::string t = word(p, eol);
+                    if (t == "s") c.source = u;
+                    else if (t == "t") c.sink = u;
+                    else {
+                        c.error = "graph loader: bad node line";
+                        return;
+                    }
+                    c.max_id = std::max(c.max_id, u);
+                    break;
+                }
+
+                case 'c':
+                case '\n':
+                case '\r':
+                    break;
+
+                default:
+                    c.error = "graph loader: unknown DIMACS line";
+                    return;
+            }
+
+            p = eol + 1;
+        }
+    }
+
+    inline void parse_edge_list(const char * p, const char * end, Chunk &c) {
+
+        while (p < end) {
+
+            const char * eol = std::find(p, end, '\n');
+            const char * q = p;
+
+            while (q < eol && blank(*q)) ++q;
+
+            if (q < eol && *q != '#' && *q != '%') {
+                long u, v, w {1};
+
+                if (!number(q, eol, u) || !number(q, eol, v) || u < 0 || v < 0 ||
+                    !in_int(u) || !in_int(v)) {
+                    c.error = "graph loader: bad edge line";
+                    return;
+                }
+
+                // optional weight, then nothing else
+                const char * r = q;
+                if (number(r, eol, w)) q = r;
+
+                if (!rest_blank(q, eol) || !in_int(w)) {
+                    c.error = "graph loader: bad edge line";
+                    return;
+                }
+
+                c.edges.push_back(GraphFile::Edge((int) u, (int) v, (int) w));
+                c.max_id = std::max(c.max_id, std::max(u, v));
+            }
+
+            p = eol + 1;
+        }
+    }
+
+    inline GraphFormat detect(const std::string &path, const char * p, const char * end) {
+
+        auto ends_with = [&path] (const char * s) {
+            size_t n = strlen(s);
+            return path.size() >= n && path.compare(path.size() - n, n, s) == 0;
+        };
+
+        if (ends_with(".gr") || ends_with(".max")) return DIMACS;
+
+        // first character of the first line which is not blank
+        while (p < end && (blank(*p) || *p == '\n')) ++p;
+
+        return p < end && (*p == 'c' || *p == 'p') ? DIMACS : EDGE_LIST;
+    }
+}
+
+
+/*
+ *  load_graph, reads graph file in the given format (by default
+ *      from the extension or content); n_threads 0 uses all cores.
+ *      Throws const char * on a malformed file.
+ */
+
+inline GraphFile load_graph(const std::string &path, GraphFormat format = FORMAT_AUTO,
+                            int n_threads = 0) {
+
+    using namespace graph_loader;
+
+    if (n_threads <= 0)
+        n_threads = std::max(1u, std::thread::hardware_concurrency());
+
+    MappedFile file(path);
+    file.sequential();
+
+    const char * begin = file.data();
+    const char * end = begin + file.size();
+
+    if (format == FORMAT_AUTO)
+        format = detect(path, begin, end);
+
+    // no point in splitting small files
+    n_threads = (int) std::min((size_t) n_threads, file.size() / (1 << 20) + 1);
+
+    // chunk boundaries, moved forward to the start of a line
+    std::vector<const char *> cut(n_threads + 1, end);
+    cut[0] = begin;
+
+    for (int t=1; t<n_threads; t++) {
+        const char * p = std::max(cut[t-1], begin + file.size() / n_threads * t);
+        while (p > begin && p < end && p[-1] != '\n') ++p;
+        cut[t] = p;
+    }
+
+    std::vector<Chunk> chunks(n_threads);
+
+    auto parse = [&] (int t) {
+        // about 1 edge per 12 bytes of text
+        chunks[t].edges.reserve((cut[t+1] - cut[t]) / 12);
+
+        if (format == DIMACS)
+            parse_dimacs(cut[t], cut[t+1], chunks[t]);
+        else
+            parse_edge_list(cut[t], cut[t+1], chunks[t]);
+    };
+
+    std::vector<std::thread> threads;
+    for (int t=1; t<n_threads; t++)
+        threads.push_back(std::thread(parse, t));
+
+    parse(0);
+
+    for (auto &th : threads)
+        th.join();
+
+    // join chunks
+
+    GraphFile g;
+    long n {-1}, m {-1}, max_id {-1}, source {-1}, sink {-1};
+    size_t total {0};
+
+    for (auto &c : chunks) {
+        if (c.error != nullptr) throw c.error;
+
+        if (c.n >= 0) {
+            if (n >= 0) throw "graph loader: more than one problem line";
+            n = c.n;
+            m = c.m;
+            g.problem = c.problem;
+        }
+
+        if (c.source >= 0) source = c.source;
+        if (c.sink >= 0) sink = c.sink;
+
+        max_id = std::max(max_id, c.max_id);
+        total += c.edges.size();
+    }
+
+    if (format == DIMACS) {
+        if (n < 0) throw "graph loader: no problem line";
+        if (max_id > n) throw "graph loader: vertex out of range";
+        if (m >= 0 && (size_t) m != total) throw "graph loader: wrong number of arcs";
+
+        if (g.problem == "max" && (source < 0 || sink < 0))
+            throw "graph loader: max problem without source or sink";
+
+        g.N = (int) n;
+        if (source >= 0) g.source = (int) source - 1;
+        if (sink >= 0) g.sink = (int) sink - 1;
+    }
+    else
+        g.N = (int) (max_id + 1);
+
+    g.edges.reserve(total);
+
+    for (auto &c : chunks) {
+        g.edges.insert(g.edges.end(), c.edges.begin(), c.edges.end());
+        std::vector<GraphFile::Edge>().swap(c.edges);      // free it now
+    }
+
+    return g;
+}
+
+#endif /* GraphLoader_hpp */
@@ -0,0 +1,475 @@
+//
+//  dary-heap.hpp
+//
+//  Implicit d-ary heap with compile-time arity, plain and indexed
+//
+//  Created by mkuklik on 12/10/15.
+//  Copyright © 2015 mkuklik. All rights reserved.
+//
+
+/*
+ *  Every node has D children instead of two, so the tree is log_D n
+ *  deep: push and decrease_key do fewer levels, pop looks at D
+ *  children per level but they are next to each other in memory.
+ *
+ *  The root is stored at index D-1, so children of node i,
+ *
+ *      first_child(i) = D * (i - D + 2), ..., first_child(i) + D - 1
+ *
+ *  always start at a multiple of D; with a 64 byte aligned array and
+ *  D * sizeof(element) <= 64 (D = 4 or 8 for ints and int pairs) all
+ *  children of a node are in one cache line. The first D-1 slots are
+ *  not used.
+ *
+ *  Sift up and down are loops which move a hole instead of swapping,
+ *  one write per level, and the smallest child is picked without
+ *  branches. pop() moves the hole all the way down to a leaf and sifts
+ *  the last element up from there (Floyd), it almost always belongs
+ *  near the bottom, which saves a comparison per level. heapify()
+ *  builds the heap bottom up in O(n).
+ *
+ *  Compare is the same as for IndexedBinaryHeap: comp(a, b) is true if
+ *  a goes before b, std::less gives a min-heap (unlike
+ *  std::priority_queue, where it gives a max-heap).
+ *
+ *  DaryHeap holds values, IndexedDaryHeap ids 0..n-1 with keys and
+ *  decrease_key, with the interface of IndexedBinaryHeap.
+ */
+
+#ifndef DaryHeap_hpp
+#define DaryHeap_hpp
+
+#include <vector>
+#include <cstdlib>
+#include <new>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include <functional>
+
+/*
+ *  CacheAlignedAllocator, std allocator which returns memory aligned
+ *      to a cache line (64 bytes)
+ */
+
+template<typename T>
+struct CacheAlignedAllocator {
+
+    typedef T value_type;
+
+    CacheAlignedAllocator() {};
+
+    template<typename U>
+    CacheAlignedAllocator(const CacheAlignedAllocator<U> &) {};
+
+    T * allocate(size_t n) {
+        void * p {nullptr};
+        if (posix_memalign(&p, 64, n * sizeof(T)) != 0) throw std::bad_alloc();
+        return (T *) p;
+    }
+
+    void deallocate(T * p, size_t) { free(p); }
+};
+
+template<typename T, typename U>
+bool operator==(const CacheAlignedAllocator<T> &, const CacheAlignedAllocator<U> &) { return true; }
+
+template<typename T, typename U>
+bool operator!=(const CacheAlignedAllocator<T> &, const CacheAlignedAllocator<U> &) { return false; }
+
+
+/*
+ *  DaryHeap, heap of values of type T
+ */
+
+template<typename T, int D = 4, typename Compare = std::less<T>>
+class DaryHeap {
+
+    static_assert(D >= 2, "DaryHeap needs at least two children per node");
+
+    enum : size_t { R = D - 1 };    // index of the root
+
+    std::vector<T, CacheAlignedAllocator<T>> a;
+    Compare comp;
+
+    static size_t parent(size_t i) { return i / D + D - 2; }
+    static size_t first_child(size_t i) { return D * (i - D + 2); }
+
+    void sift_up(size_t i) {
+
+        T x = std::move(a[i]);
+
+        while (i != R) {
+
+            size_t p = parent(i);
+
+            if (!comp(x, a[p])) break;
+
+            a[i] = std::move(a[p]);
+            i = p;
+        }
+
+        a[i] = std::move(x);
+    }
+
+    size_t min_child(size_t c, size_t end) const {
+
+        size_t best {c};
+        const T * b = &a[c];
+
+        for (size_t j = c + 1; j < end; j++) {
+            bool less = comp(a[j], *b);
+            best = less ? j : best;
+            b = less ? &a[j] : b;
+        }
+
+        return best;
+    }
+
+    void sift_down(size_t i) {
+
+        size_t n = a.size();
+        T x = std::move(a[i]);
+
+        while (true) {
+
+            size_t c = first_child(i);
+
+            if (c >= n) break;
+
+            size_t best = min_child(c, std::min(c + D, n));
+
+            if (!comp(a[best], x)) break;
+
+            a[i] = std::move(a[best]);
+            i = best;
+        }
+
+        a[i] = std::move(x);
+    }
+
+    void sift_down_to_leaf(size_t i) {
+
+        size_t n = a.size();
+        T x = std::move(a[i]);
+
+        while (true) {
+
+            size_t c = first_child(i);
+
+            if (c >= n) break;
+
+            size_t best = c + D <= n ? min_child(c, c + D) : min_child(c, n);
+
+            a[i] = std::move(a[best]);
+            i = best;
+        }
+
+        a[i] = std::move(x);
+        sift_up(i);
+    }
+
+    /*
+     *  restore, a[R..from) is a heap and the k elements from `from` on
+     *      were appended; either sift every new one up, O(k log n), or
+     *      build the whole heap again, O(n), whichever is cheaper
+     */
+
+    void restore(size_t from) {
+
+        size_t n = a.size();
+
+        size_t levels {0};
+        for (size_t x = size(); x > 1; x /= D) ++levels;
+
+        if ((n - from) * levels > size()) {
+            if (size() > 1)
+                for (size_t i = parent(n - 1) + 1; i != R; )
+                    sift_down(--i);
+        }
+        else
+            for (size_t i = from; i < n; i++)
+                sift_up(i);
+    }
+
+public:
+
+    DaryHeap(Compare c = Compare()): a(R), comp(c) {};
+
+    /*
+     *  heap of the elements of [first, last), built with heapify
+     */
+
+    template<typename It>
+    DaryHeap(It first, It last, Compare c = Compare()): comp(c) {
+        heapify(first, last);
+    }
+
+    bool empty() const { return a.size() == R; }
+
+    size_t size() const { return a.size() - R; }
+
+    void reserve(size_t n) { a.reserve(n + R); }
+
+    void clear() { a.resize(R); }
+
+    /*
+     *  top, element which goes first
+     */
+
+    const T & top() const {
+        if (empty()) throw "heap is empty";
+        return a[R];
+    }
+
+    void push(const T &x) {
+        a.push_back(x);
+        sift_up(a.size() - 1);
+    }
+
+    void push(T &&x) {
+        a.push_back(std::move(x));
+        sift_up(a.size() - 1);
+    }
+
+    /*
+     *  pop, remove the top element and return it
+     */
+
+    T pop() {
+        if (empty()) throw "heap is empty";
+
+        T x = std::move(a[R]);
+
+        if (a.size() > R + 1) {
+            a[R] = std::move(a.back());
+            a.pop_back();
+            sift_down_to_leaf(R);
+        }
+        else
+            a.pop_back();
+
+        return x;
+    }
+
+    /*
+     *  heapify, replace the contents with [first, last) and build the
+     *      heap bottom up, O(n)
+     */
+
+    template<typename It>
+    void heapify(It first, It last) {
+
+        a.resize(R);
+        a.insert(a.end(), first, last);
+
+        if (size() < 2) return;
+
+        for (size_t i = parent(a.size() - 1) + 1; i != R; )
+            sift_down(--i);
+    }
+
+    /*
+     *  insert_range, add the elements of [first, last)
+     */
+
+    template<typename It>
+    void insert_range(It first, It last) {
+
+        size_t from = a.size();
+        a.insert(a.end(), first, last);
+        restore(from);
+    }
+
+    /*
+     *  meld, move all elements of other to this heap, O(n + m);
+     *      other is left empty
+     */
+
+    void meld(DaryHeap &other) {
+
+        if (&other == this) return;
+
+        size_t from = a.size();
+        a.insert(a.end(), std::make_move_iterator(other.a.begin() + R),
+                 std::make_move_iterator(other.a.end()));
+        other.clear();
+        restore(from);
+    }
+};
+
+
+/*
+ *  IndexedDaryHeap, min-heap over integer ids 0..n-1 with keys of type
+ *  K, the same as IndexedBinaryHeap but d-ary. The heap array holds
+ *  (key, id) pairs so comparisons don't leave the array; pos maps an id
+ *  to its index in heap, npos if not in the heap.
+ */
+
+template<typename K, int D = 4, typename Compare = std::less<K>>
+class IndexedDaryHeap {
+
+    static_assert(D >= 2, "IndexedDaryHeap needs at least two children per node");
+
+    enum : size_t { R = D - 1 };
+
+    struct Entry {
+        K key;
+        int id;
+    };
+
+    std::vector<Entry, CacheAlignedAllocator<Entry>> heap;
+    std::vector<size_t> pos;        // id -> index in heap
+    Compare comp;
+
+    static size_t parent(size_t i) { return i / D + D - 2; }
+    static size_t first_child(size_t i) { return D * (i - D + 2); }
+
+    void place(size_t i, const Entry &e) {
+        heap[i] = e;
+        pos[e.id] = i;
+    }
+
+    void sift_up(size_t i) {
+
+        Entry x = heap[i];
+
+        while (i != R) {
+
+            size_t p = parent(i);
+
+            if (!comp(x.key, heap[p].key)) break;
+
+            place(i, heap[p]);
+            i = p;
+        }
+
+        place(i, x);
+    }
+
+    size_t min_child(size_t c, size_t end) const {
+
+        size_t best {c};
+        const K * b = &heap[c].key;
+
+        for (size_t j = c + 1; j < end; j++) {
+            bool less = comp(heap[j].key, *b);
+            best = less ? j : best;
+            b = less ? &heap[j].key : b;
+        }
+
+        return best;
+    }
+
+    void sift_down_to_leaf(size_t i) {
+
+        size_t n = heap.size();
+        Entry x = heap[i];
+
+        while (true) {
+
+            size_t c = first_child(i);
+
+            if (c >= n) break;
+
+            size_t best = c + D <= n ? min_child(c, c + D) : min_child(c, n);
+
+            place(i, heap[best]);
+            i = best;
+        }
+
+        place(i, x);
+        sift_up(i);
+    }
+
+public:
+
+    enum : size_t { npos = (size_t) -1 };   // marks ids not in the heap
+
+    IndexedDaryHeap(int n, Compare c = Compare()): heap(R), pos(n, npos), comp(c) {
+        heap.reserve(n + R);
+    };
+
+    bool empty() const { return heap.size() == R; }
+
+    size_t size() const { return heap.size() - R; }
+
+    bool contains(int id) const { return pos[id] != npos; }
+
+    /*
+     *  key_of, key of id, which must be in the heap
+     */
+
+    const K & key_of(int id) const { return heap[pos[id]].key; }
+
+    /*
+     *  top, id with the lowest key
+     */
+
+    int top() const {
+        if (empty()) throw "heap is empty";
+        return heap[R].id;
+    }
+
+    /*
+     *  insert id with key k, id must not be in the heap
+     */
+
+    void insert(int id, const K &k) {
+        if (contains(id)) throw "id is already in the heap";
+
+        heap.push_back(Entry {k, id});
+        sift_up(heap.size() - 1);
+    }
+
+    /*
+     *  pop, remove id with the lowest key and return it
+     */
+
+    int pop() {
+        if (empty()) throw "heap is empty";
+
+        int id = heap[R].id;
+        pos[id] = npos;
+
+        if (heap.size() > R + 1) {
+            heap[R] = heap.back();
+            heap.pop_back();
+            sift_down_to_leaf(R);
+        }
+        else
+            heap.pop_back();
+
+        return id;
+    }
+
+    /*
+     *  decrease_key, id must be in the heap and k must not be worse than current key
+     */
+
+    void decrease_key(int id, const K &k) {
+        if (!contains(id)) throw "id is not in the heap";
+        if (comp(heap[pos[id]].key, k)) throw "new key is greater than current key";
+
+        heap[pos[id]].key = k;
+        sift_up(pos[id]);
+    }
+
+    /*
+     *  insert_or_decrease, inserts id or decreases its key if already present
+     */
+
+    void insert_or_decrease(int id, const K &k) {
+        if (contains(id))
+            decrease_key(id, k);
+        else
+            insert(id, k);
+    }
+
+    void clear() {
+        for (size_t i = R; i < heap.size(); i++) pos[heap[i].id] = npos;
+        heap.resize(R);
+    }
+};
+
+#endif /* DaryHeap_hpp */
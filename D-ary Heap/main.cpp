@@ -0,0 +1,50 @@
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <random>
+
+#include "dary-heap.hpp"
+
+/*
+ *  D-ary Heap
+ *
+ *  Created by mkuklik on 12/10/15.
+ *  Copyright © 2015 mkuklik. All rights reserved.
+ */
+
+/*
+ *  Main
+ */
+
+int main(int argc, const char * argv[]) {
+
+    std::vector<int> x1(20);
+    generate(x1.begin(), x1.end(), []() -> int { return std::rand()%100; });
+
+    for (auto x: x1) std::cout << x << " ";
+    std::cout << std::endl;
+
+    // max-heap with 8 children per node, built in O(n)
+    DaryHeap<int, 8, std::greater<int>> h(x1.begin(), x1.end());
+
+    h.push(100);
+
+    while (!h.empty()) std::cout << h.pop() << " ";
+    std::cout << std::endl;
+
+    // indexed min-heap, ids 0..9
+    IndexedDaryHeap<int, 4> q(10);
+
+    for (int i=0; i<10; i++)
+        q.insert(i, x1[i]);
+
+    q.decrease_key(5, -1);
+    q.decrease_key(8, -2);
+
+    while (!q.empty()) {
+        int id = q.top();
+        std::cout << q.key_of(id) << "(" << id << ") ";
+        q.pop();
+    }
+    std::cout << std::endl;
+}
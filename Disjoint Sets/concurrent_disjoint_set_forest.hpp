@@ -0,0 +1,167 @@
+//
+//  concurrent_disjoint_set_forest.hpp
+//
+//  Lock-free disjoint set forest, join and same_set can be called
+//  from many threads at once
+//
+//  Created by mkuklik on 11/28/15.
+//  Copyright © 2015 mkuklik. All rights reserved.
+//
+
+/*
+ *  Same flat parent array as DisjointSetForest, but every entry is an
+ *  atomic and all changes are done with compare-and-swap
+ *  (Anderson, Woll 1991; Jayanti, Tarjan 2016)
+ *
+ *  find_set, path splitting: every node on the path is pointed to its
+ *      grandparent with one CAS. A failed CAS is ignored, it only means
+ *      another thread already moved the node up, the path is still valid.
+ *      find never waits for other threads.
+ *
+ *  join, link the roots with CAS on parent of one of them, succeeds only
+ *      if it's still a root; otherwise roots are found again and join
+ *      retries. Root with the lower id is linked under the higher one,
+ *      ranks are not kept as root and rank can't be changed in one CAS.
+ *      With path splitting this stays near linear in practice.
+ *
+ *  same_set, if roots differ the answer is only "no" if the first root
+ *      is still a root after the second one was found, else retry.
+ */
+
+#ifndef ConcurrentDisjointSetForest_hpp
+#define ConcurrentDisjointSetForest_hpp
+
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <utility>
+#include <algorithm>
+#include <functional>
+
+class ConcurrentDisjointSetForest {
+
+    int N;                              // number of elements
+    std::atomic<int> nsets;             // current number of sets
+    std::vector<std::atomic<int>> parent;
+
+public:
+
+    ConcurrentDisjointSetForest(int n): N(n), nsets(n), parent(n) {
+
+        for (int i=0; i<N; i++)
+            parent[i].store(i, std::memory_order_relaxed);
+    }
+
+    /*
+     *  find head node of the set, which contains element x;
+     */
+
+    int find_set(int x) {
+
+        while (true) {
+            int p = parent[x].load(std::memory_order_acquire);
+            int gp = parent[p].load(std::memory_order_acquire);
+
+            if (p == gp) return p;
+
+            parent[x].compare_exchange_weak(p, gp, std::memory_order_release,
+                                            std::memory_order_relaxed);  // path splitting
+            x = p;
+        }
+    }
+
+    /*
+     *  join is a union of two sets identified by two elements,
+     *      returns true if the sets were different
+     */
+
+    bool join(int a, int b) {
+
+        while (true) {
+
+            int ra = find_set(a);
+            int rb = find_set(b);
+
+            if (ra == rb) return false;
+
+            if (ra > rb) std::swap(ra, rb);
+
+            // link ra under rb, only if ra is still a root
+            if (parent[ra].compare_exchange_strong(ra, rb, std::memory_order_acq_rel)) {
+                nsets.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+    }
+
+    /*
+     *  compares if two elements are from the same set
+     */
+
+    bool same_set(int a, int b) {
+
+        while (true) {
+
+            int ra = find_set(a);
+            int rb = find_set(b);
+
+            if (ra == rb) return true;
+
+            if (parent[ra].load(std::memory_order_acquire) == ra) return false;
+        }
+    }
+
+    /*
+     *  n_sets, returns number of sets
+     */
+
+    int n_sets() { return nsets.load(); }
+
+    int size() { return N; }
+};
+
+
+/*
+ *  connected_components of a graph with n vertices, edges are split into
+ *      n_threads contiguous chunks joined in parallel; component[v] is
+ *      the id of the head vertex of v's component.
+ *      Returns the number of components.
+ */
+
+inline int connected_components(int n, const std::vector<std::pair<int, int>> &edges,
+                                std::vector<int> &component, int n_threads = 0) {
+
+    if (n_threads <= 0)
+        n_threads = std::max(1u, std::thread::hardware_concurrency());
+
+    ConcurrentDisjointSetForest d(n);
+    component.resize(n);
+
+    // run f(begin, end) on n_threads chunks of [0, m)
+    auto parallel = [n_threads] (size_t m, const std::function<void(size_t, size_t)> &f) {
+        std::vector<std::thread> threads;
+        size_t chunk = (m + n_threads - 1) / n_threads;
+
+        for (int t=1; t < n_threads; t++)
+            threads.push_back(std::thread(f, std::min(m, t*chunk), std::min(m, (t+1)*chunk)));
+
+        f(0, std::min(m, chunk));
+
+        for (auto &th : threads)
+            th.join();
+    };
+
+    parallel(edges.size(), [&] (size_t begin, size_t end) {
+        for (size_t i=begin; i<end; i++)
+            d.join(edges[i].first, edges[i].second);
+    });
+
+    parallel(n, [&] (size_t begin, size_t end) {
+        for (size_t v=begin; v<end; v++)
+            component[v] = d.find_set((int) v);
+    });
+
+    return d.n_sets();
+}
+
+#endif /* ConcurrentDisjointSetForest_hpp */
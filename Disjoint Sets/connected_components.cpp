@@ -0,0 +1,53 @@
+//
+//  Connected Components
+//
+//  parallel connected components of a random graph with the
+//  lock-free disjoint set forest, checked against DisjointSetForest
+//
+//  Created by mkuklik on 11/28/15.
+//  Copyright © 2015 mkuklik. All rights reserved.
+//
+
+#include <iostream>
+#include <vector>
+#include <random>
+
+#include "disjoint_set_forest.hpp"
+#include "concurrent_disjoint_set_forest.hpp"
+
+using namespace std;
+
+int main(int argc, const char * argv[]) {
+    
+    const int N = 1000000;
+    const int M = 600000;
+    
+    // random edges
+    mt19937 rng(42);
+    vector<pair<int, int>> edges;
+    edges.reserve(M);
+    
+    for (int i=0; i<M; i++)
+        edges.push_back(make_pair((int) (rng() % N), (int) (rng() % N)));
+    
+    // parallel
+    vector<int> component;
+    int n = connected_components(N, edges, component, 4);
+    
+    // sequential
+    DisjointSetForest d(N);
+    for (auto &e : edges)
+        d.join(e.first, e.second);
+    
+    cout << "components: " << n << " (parallel) " << d.n_sets() << " (sequential)" << endl;
+    
+    // the same partition, v and its component head are in the same set
+    bool same {true};
+    for (int v=0; v<N; v++)
+        if (!d.same_set(v, component[v]))
+            same = false;
+    
+    cout << (same ? "same components" : "SNAFU, components differ") << endl;
+    
+    return 0;
+}
@@ -0,0 +1,156 @@
+//
+//  disjoint_set_forest.hpp
+//
+//  Created by mkuklik on 11/8/15.
+//  Copyright © 2015 mkuklik. All rights reserved.
+//
+
+#ifndef DisjointSetForest_hpp
+#define DisjointSetForest_hpp
+
+#include <iostream>
+#include <vector>
+#include <map>      // only for printing
+#include <cstdint>
+
+/*
+ *  Elements are integers 0..N-1 and the forest is kept in two flat
+ *  arrays instead of one heap allocated Node per element:
+ *
+ *      parent[x]   parent of x, parent[x] == x for the head of a set
+ *      rank[x]     upper bound on height of the tree under x
+ *
+ *  which is 5 bytes per element. Rank fits in a byte as it is at most
+ *  log2(N).
+ *
+ *  find_set is iterative with path halving: every node on the path is
+ *  linked to its grandparent. It keeps the same amortized bound as full
+ *  path compression, needs one pass and no recursion, so deep trees
+ *  don't overflow the stack.
+ */
+
+class DisjointSetForest {
+    
+    int N;                          // original number of sets
+    int nsets;                      // current number of distinguished sets
+    std::vector<int> parent;
+    std::vector<uint8_t> rank;
+    
+    /*
+     *  Link two trees, union by rank
+     */
+    
+    void link(int x, int y) {
+        
+        if (rank[x] > rank[y])
+            
+            parent[y] = x;
+        
+        else {
+            
+            parent[x] = y;
+            
+            if (rank[x] == rank[y]) // if both are equal rank then linking x to y
+                // will increase y's rank
+                rank[y]++;
+        }
+    }
+    
+public:
+    
+    DisjointSetForest(int n): N(n), nsets(N), parent(n), rank(n, 0) {
+        
+        for (int i=0; i<N; i++)
+            parent[i] = i;
+    }
+    
+    /*
+     *  find head node of the set, which contains element x;
+     */
+    
+    int find_set(int x) {
+        
+        while (parent[x] != x) {
+            parent[x] = parent[parent[x]];  // path halving
+            x = parent[x];
+        }
+        
+        return x;
+    }
+    
+    /*
+     *  make_set, create a new set and returns element's id
+     */
+    
+    int make_set() {
+        
+        parent.push_back((int) parent.size());
+        rank.push_back(0);
+        ++nsets;
+        
+        return (int) parent.size() - 1;
+    }
+    
+    /*
+     *  join is a union of two sets identified by two elements
+     */
+    
+    void join(int a, int b) {
+        
+        int pa = find_set(a);
+        int pb = find_set(b);
+        
+        
+        if (pa != pb) {
+            
+            link(pa, pb);
+            --nsets;
+        }
+    }
+    
+    
+    /*
+     *  n_sets, returns number of sets
+     */
+    
+    int n_sets() { return nsets; }
+    
+    int size() { return (int) parent.size(); }
+    
+    
+    /*
+     *  compares if two elements are from the same set
+     */
+    bool same_set(int a, int b) {
+        return find_set(a) == find_set(b);
+    }
+    
+    
+    /*
+     *  print sets
+     */
+    
+    void print() {
+        int n = size();
+        
+        std::map<int, int> m;
+        
+        int set_counter {0};
+        
+        for (int i=0; i<n; i++) {
+            int s = find_set(i);
+            
+            auto x = m.find(s);
+            
+            if (x ==  m.end())
+                m.insert(std::pair<int, int>(s, set_counter++));
+        }
+        
+        std::cout << nsets << ": ";
+        for (int i=0; i < n; i++)
+            std::cout << i << " P(" << m[find_set(i)] << ") ";
+        std::cout << std::endl;
+    }
+};
+
+#endif /* DisjointSetForest_hpp */
@@ -9,6 +9,9 @@
 #include <vector>
 #include <cmath>
 #include <cassert>
+#include <climits>
+
+#include "../Memory Pool/node-pool.hpp"
 
 struct FibonacciHeap {
     
@@ -35,8 +38,22 @@ struct FibonacciHeap {
         Node(int k): key(k) {};
     };
     
+    /*
+     *  A node of degree d roots a tree of at least F(d+2) >= phi^d nodes,
+     *  so with N < 2^31 no degree is above log_phi(2^31) < 45
+     */
+    
+    enum { MAX_DEGREE = 45 };
+    
     int N{0};                   // number of nodes in the heap
     Node* root {nullptr};       // points to the root list with lowest key
+    
+    NodePool<Node> pool;        // all nodes live in the pool, see node-pool.hpp
+    
+    // scratch of consolidate, kept between calls so that remove_min
+    // doesn't allocate
+    std::vector<Node *> root_list;
+    Node * by_degree[MAX_DEGREE] {};
 
     /*
      *  Methods
@@ -56,6 +73,9 @@ struct FibonacciHeap {
     void change_key(Node * x, int k);
     void remove(Node * x);      // remove Node
     int size() { return N; };
+    Node * new_node(int k) { return pool.create(k); }  // node owned by the heap
+    void reserve(int n) { pool.reserve(n); }
+    void clear();               // remove all nodes in O(1)
 
     /* priting/debugging functions */
     
@@ -84,7 +104,7 @@ void FibonacciHeap::list_insert(Node* x, Node* l, Node* r) {
 
 FibonacciHeap::Node* FibonacciHeap::insert(int k) {
 
-    Node* tmp = new Node(k);
+    Node* tmp = new_node(k);
     
     if (root == nullptr) {
 
@@ -146,7 +166,7 @@ void FibonacciHeap::remove_min() {
         consolidate();
     }
     --N;
-    delete z;
+    pool.destroy(z);
 }
 
 /*
@@ -204,16 +224,13 @@ void FibonacciHeap::consolidate() {
     if (root == nullptr)
         throw "consolidate: Heap is empty";
     
-    // size of the array required for consolidation
-    const int D { (int) floor(log( (double) N)/log((1.0 + sqrt(5))/2.0)) };
-    
-    std::vector<Node * > A(D, nullptr);
+    // A is indexed by degree, all entries are nullptr between calls
+    Node ** A {by_degree};
+    int max_d {0};
     
     // pointers to all the nodes in the root list are stored in vector root_list
     // Note that relinking nodes disrupts iteration over nodes via linked linst pointers
-    std::vector<Node * > root_list;
-    
-    root_list.reserve(N); // pick better size
+    root_list.clear();  // keeps its capacity, no allocation once it has grown
     
     // populate root_list
     //      it is a bad idea to iterate over the root linked-list
@@ -234,7 +251,7 @@ void FibonacciHeap::consolidate() {
         Node* x {w};
         int d = x->degree;
         
-        assert(d < D); // if D is too small A overflows
+        assert(d < MAX_DEGREE);
         
         // if tree with the same degree is in A, link them
         while (A[d] != nullptr) {
@@ -246,18 +263,20 @@ void FibonacciHeap::consolidate() {
             A[d] = nullptr;
             ++d;
             
-            //assert(A[d]==nullptr);  // what if x replaces existing pointer in A[d++] ?
+            assert(d < MAX_DEGREE);
         }
+        
         // if A[d] is empty x goes to A[d]
         // if x is linked with tree in A[d], x has higher degree
         A[d] = x;
         
+        if (d > max_d) max_d = d;
     }
     
     // reset root;
     root = nullptr;
     
-    for (int i = 0; i < D; i++) {
+    for (int i = 0; i <= max_d; i++) {
         
         if (A[i] != nullptr) {
             
@@ -278,6 +297,8 @@ void FibonacciHeap::consolidate() {
                 if (A[i]->key < root->key)
                     root = A[i];
             }
+            
+            A[i] = nullptr;
         }
     }
 }
@@ -381,10 +402,21 @@ void FibonacciHeap::remove(Node * x) {
 
 FibonacciHeap::~FibonacciHeap() {
     
-    deallocate(root);
+    // nodes are released together with the pool
     
 }
 
+/*
+ *  clear, releases all the nodes at once
+ */
+
+void FibonacciHeap::clear() {
+    
+    pool.reset();
+    root = nullptr;
+    N = 0;
+}
+
 void FibonacciHeap::deallocate(Node *x) {
     
     if (x == nullptr) return;
@@ -410,7 +442,7 @@ void FibonacciHeap::deallocate(Node *x) {
         c = n;
     }
     
-    delete x;
+    pool.destroy(x);
 }
 
 /*
@@ -505,6 +537,12 @@ void FibonacciHeap::change_key(Node * x, int k) {
         
         x->child = nullptr;
         x->degree = 0;
+        
+        // x was the minimum, the new one is somewhere in the root list
+        if (root == x)
+            for (Node* w = x->right; w != x; w = w->right)
+                if (w->key < root->key)
+                    root = w;
     }
 }
 
@@ -522,9 +560,9 @@ void sort_test(FibonacciHeap &h);
 int main(int argc, const char * argv[]) {
     // insert code here...
 
-    // NOTE: in test_heap 1,2,3, nodes are allocated outside
-    // of the FibonacciHeap but FibonacciHeap internal functions
-    // deallocate those nodes; thus Valgrind shows lost records
+    // NOTE: in test_heap 1,2,3, trees are built by hand outside
+    // of the FibonacciHeap, nodes are taken from the heap's pool
+    // with new_node() so the heap releases all of them
     
     // min extraction, consolidation & key decrease debugging
     test_heap1();
@@ -574,7 +612,7 @@ void test_heap1() {
     
     for (int i=0; i<6; i++) {
         
-        FibonacciHeap::Node * n = new FibonacciHeap::Node(k[i]);
+        FibonacciHeap::Node * n = h.new_node(k[i]);
         nodes.push_back(n);
     }
     
@@ -595,7 +633,7 @@ void test_heap1() {
     int kk[] {18, 52, 38};
     int dd[] {1,0,1};
     for (int i=0; i<3; i++) {
-        FibonacciHeap::Node * n = new FibonacciHeap::Node(kk[i]);
+        FibonacciHeap::Node * n = h.new_node(kk[i]);
         nodes.push_back(n);
         n->parent = nodes[3];
         n->degree = dd[i];
@@ -612,7 +650,7 @@ void test_heap1() {
     nodes[3]->child = nodes[6];
     
     // 39,  nodes[9];
-    FibonacciHeap::Node * n = new FibonacciHeap::Node(39);
+    FibonacciHeap::Node * n = h.new_node(39);
     nodes.push_back(n);
     n->parent = nodes[6];
     n->right = n;
@@ -621,7 +659,7 @@ void test_heap1() {
     nodes[6]->child = n;
     
     // 41
-    n = new FibonacciHeap::Node(41);
+    n = h.new_node(41);
     nodes.push_back(n);
     n->parent = nodes[8];
     n->right = n;
@@ -632,7 +670,7 @@ void test_heap1() {
     FibonacciHeap::Node * n41 {n};
     
     // 30
-    n = new FibonacciHeap::Node(30);
+    n = h.new_node(30);
     nodes.push_back(n);
     n->parent = nodes[4];
     n->right = n;
@@ -641,7 +679,7 @@ void test_heap1() {
     nodes[4]->child = n;
     
     // 26
-    n = new FibonacciHeap::Node(26);
+    n = h.new_node(26);
     nodes.push_back(n);
     n->parent = nodes[5];
     n->right = n;
@@ -651,7 +689,7 @@ void test_heap1() {
     nodes[5]->child = n;
     
     // 35
-    FibonacciHeap::Node * nn = new FibonacciHeap::Node(35);
+    FibonacciHeap::Node * nn = h.new_node(35);
     nodes.push_back(nn);
     nn->parent = n;
     nn->right = nn;
@@ -662,7 +700,7 @@ void test_heap1() {
     FibonacciHeap::Node * n35 {nn};
     
     // 46
-    nn = new FibonacciHeap::Node(46);
+    nn = h.new_node(46);
     nodes.push_back(nn);
     nn->parent = nodes[5];
     nn->right = n;
@@ -721,7 +759,7 @@ void test_heap2() {
     
     for (int i=0; i<6; i++) {
         
-        FibonacciHeap::Node * n = new FibonacciHeap::Node(k[i]);
+        FibonacciHeap::Node * n = h.new_node(k[i]);
         nodes.push_back(n);
     }
     
@@ -739,7 +777,7 @@ void test_heap2() {
     int kk[] {18, 52, 38};
     int dd[] {1,0,1};
     for (int i=0; i<3; i++) {
-        FibonacciHeap::Node * n = new FibonacciHeap::Node(kk[i]);
+        FibonacciHeap::Node * n = h.new_node(kk[i]);
         nodes.push_back(n);
         n->parent = nodes[3];
         n->degree = dd[i];
@@ -756,7 +794,7 @@ void test_heap2() {
     nodes[3]->child = nodes[6];
     
     // 39,  nodes[9];
-    FibonacciHeap::Node * n = new FibonacciHeap::Node(39);
+    FibonacciHeap::Node * n = h.new_node(39);
     nodes.push_back(n);
     n->parent = nodes[6];
     n->right = n;
@@ -765,7 +803,7 @@ void test_heap2() {
     nodes[6]->child = n;
     
     // 41
-    n = new FibonacciHeap::Node(41);
+    n = h.new_node(41);
     nodes.push_back(n);
     n->parent = nodes[8];
     n->right = n;
@@ -774,7 +812,7 @@ void test_heap2() {
     nodes[8]->child = n;
     
     // 30
-    n = new FibonacciHeap::Node(30);
+    n = h.new_node(30);
     nodes.push_back(n);
     n->parent = nodes[4];
     n->right = n;
@@ -783,7 +821,7 @@ void test_heap2() {
     nodes[4]->child = n;
     
     // 26
-    n = new FibonacciHeap::Node(26);
+    n = h.new_node(26);
     nodes.push_back(n);
     n->parent = nodes[5];
     n->right = n;
@@ -793,7 +831,7 @@ void test_heap2() {
     nodes[5]->child = n;
     
     // 35
-    FibonacciHeap::Node * nn = new FibonacciHeap::Node(35);
+    FibonacciHeap::Node * nn = h.new_node(35);
     nodes.push_back(nn);
     nn->parent = n;
     nn->right = nn;
@@ -802,7 +840,7 @@ void test_heap2() {
     n->child = nn;
     
     // 46
-    nn = new FibonacciHeap::Node(46);
+    nn = h.new_node(46);
     nodes.push_back(nn);
     nn->parent = nodes[5];
     nn->right = n;
@@ -838,7 +876,7 @@ void test_heap3() {
     
     for (int i=0; i<6; i++) {
         
-        FibonacciHeap::Node * n = new FibonacciHeap::Node(k[i]);
+        FibonacciHeap::Node * n = h.new_node(k[i]);
         nodes.push_back(n);
     }
     
@@ -859,7 +897,7 @@ void test_heap3() {
     int kk[] {18, 52, 38};
     int dd[] {1,0,1};
     for (int i=0; i<3; i++) {
-        FibonacciHeap::Node * n = new FibonacciHeap::Node(kk[i]);
+        FibonacciHeap::Node * n = h.new_node(kk[i]);
         nodes.push_back(n);
         n->parent = nodes[3];
         n->degree = dd[i];
@@ -876,7 +914,7 @@ void test_heap3() {
     nodes[3]->child = nodes[6];
     
     // 39,  nodes[9];
-    FibonacciHeap::Node * n = new FibonacciHeap::Node(39);
+    FibonacciHeap::Node * n = h.new_node(39);
     nodes.push_back(n);
     n->parent = nodes[6];
     n->right = n;
@@ -885,7 +923,7 @@ void test_heap3() {
     nodes[6]->child = n;
     
     // 41
-    n = new FibonacciHeap::Node(41);
+    n = h.new_node(41);
     nodes.push_back(n);
     n->parent = nodes[8];
     n->right = n;
@@ -894,7 +932,7 @@ void test_heap3() {
     nodes[8]->child = n;
     
     // 30
-    n = new FibonacciHeap::Node(30);
+    n = h.new_node(30);
     nodes.push_back(n);
     n->parent = nodes[4];
     n->right = n;
@@ -903,7 +941,7 @@ void test_heap3() {
     nodes[4]->child = n;
     
     // 26
-    n = new FibonacciHeap::Node(26);
+    n = h.new_node(26);
     nodes.push_back(n);
     n->parent = nodes[5];
     n->right = n;
@@ -913,7 +951,7 @@ void test_heap3() {
     nodes[5]->child = n;
     
     // 35
-    FibonacciHeap::Node * nn = new FibonacciHeap::Node(35);
+    FibonacciHeap::Node * nn = h.new_node(35);
     nodes.push_back(nn);
     nn->parent = n;
     nn->right = nn;
@@ -922,7 +960,7 @@ void test_heap3() {
     n->child = nn;
     
     // 46
-    nn = new FibonacciHeap::Node(46);
+    nn = h.new_node(46);
     nodes.push_back(nn);
     nn->parent = nodes[5];
     nn->right = n;
@@ -10,6 +10,9 @@
 #include <vector>
 #include <iterator>
 #include <queue>
+#include <climits>
+
+#include "max-flow.hpp"
 
 /* 
  *  Graph is a data structure that stores original and residual graph
@@ -89,6 +92,7 @@ private:
     const int N {0};
     
     std::vector<Edge *> vertices;
+    std::vector<Edge *> edges;      // original edges in insertion order
     
     /*
      *  add edge to a adjacency list
@@ -145,6 +149,34 @@ public:
         rev->_residaul_capacity = 0;
         
         add_edge(to, rev);  // insert rev
+        
+        edges.push_back(e);
+    }
+    
+    /*
+     *  csr, residual graph in CSR form, arcs keep the order
+     *      of the adjacency lists
+     */
+    
+    CSRResidualGraph<int> csr() const {
+        
+        std::vector<CSRGraph<int>::Edge> list;
+        list.reserve(edges.size());
+        
+        for (auto e : edges)
+            list.push_back(CSRGraph<int>::Edge(e->from, e->to, e->_capacity));
+        
+        return CSRResidualGraph<int>(N, list);
+    }
+    
+    /*
+     *  update_flows, copy flows computed on the CSR residual graph
+     *      back to the edges
+     */
+    
+    void update_flows(const CSRResidualGraph<int> &r) {
+        for (size_t i=0; i<edges.size(); i++)
+            edges[i]->update_to(r.flow((int) i));
     }
     
     /*
@@ -255,87 +287,24 @@ public:
 
 
 /*
- *  Ford - Fulkerson algorithms
- *  Edmonds Karp version with augmented path search using
- *      BFS with unit edges
+ *  max_flow on the linked-list Graph, flows are computed
+ *  on the CSR copy and written back to the edges
  */
 
-int edmonds_karp(Graph &g, int start, int end)
+int max_flow(Graph &g, int start, int end, MaxFlowAlgorithm algorithm)
 {
-    int N = g.n_vertices();
-    
-    // reset all flows to zero
-    for (int i=0; i<N; i++) {
-        for (auto it=g.begin(i); it != g.end(); ++it) {
-            (*it).update_to(0.0);
-        }
-    }
+    auto r = g.csr();
     
-    // while there exists a path p from s to t in the residual graph;
-    while (true) {
-
-        // find shortest path in residual graph using BFS under assumption
-        // that each edge has unit distance.
-        
-        // BFS BEGIN
-        
-        enum COLOR { WHITE, GRAY, BLACK};
-        std::vector<COLOR> color(N, WHITE);
-        std::vector<int> dist(N, 0);
-        std::vector<int> previous(N, -1);
-        std::vector<Graph::resid_iterator> edge_to(N, nullptr); // store pointers to edges
-                                                                // leading to vertex v
-        std::queue<int> q;
-        q.push(start);
-        color[start] = GRAY;
-        dist[start] = 0;    // redundant, only here for exposition of BFS
-        
-        while (q.size() > 0) {
-            
-            int v = q.front();
-            q.pop();
-            
-            for (auto it=g.resid_begin(v); it != g.resid_end(); ++it) {
-                int to = (*it).to;
-                if (color[to] == WHITE) {
-                    q.push(to);
-                    color[to] = GRAY;
-                    
-                    dist[to] = dist[v] + 1;
-                    previous[to] = v;
-                    edge_to[to] = it;   // save edge leading to vertex "to"
-                }
-            }
-            color[v] = BLACK;
-        }
-        // BFS END
-        
-        // if (no path) break
-        if (previous[end] == -1) break;
-        
-        // finding minimum residual_capacity along the path
-        int cf {INT_MAX};
-        int i {end};
-        while (i != start) {
-            int tmp = (*edge_to[i]).residaul_capacity();
-            if (tmp < cf) cf = tmp;
-            i = previous[i];
-        }
-        
-        // update graph
-        i = end;
-        while (i != start) {
-            (*edge_to[i]).update_by(cf);    // notice that update() distinguishes
-            i = previous[i];                // between original and reverse edge
-        }
-    }
+    int flow = max_flow(r, start, end, algorithm);
     
-    // calculate maximum from the start node
-    int max_flow {0};
-    for (auto it=g.begin(start); it != g.end(0); ++it)
-        max_flow += (*it).flow();
+    g.update_flows(r);
     
-    return max_flow;
+    return flow;
+}
+
+int edmonds_karp(Graph &g, int start, int end)
+{
+    return max_flow(g, start, end, EDMONDS_KARP);
 }
 
 
@@ -420,5 +389,25 @@ int main(int argc, const char * argv[]) {
                  "flow graph: \n";
     g3.print();
     
+    // Example 1 with Dinic's and push-relabel
+    
+    std::cout << " ------------------ \n";
+    std::cout << "\n Example 1, Dinic \n\n";
+    
+    auto m4 = max_flow(g, 0, 5, DINIC);
+    
+    std::cout << "max flow is " << m4 << std::endl << std::endl <<
+                 "flow graph: \n";
+    g.print();
+    
+    std::cout << " ------------------ \n";
+    std::cout << "\n Example 1, push-relabel \n\n";
+    
+    auto m5 = max_flow(g, 0, 5, PUSH_RELABEL);
+    
+    std::cout << "max flow is " << m5 << std::endl << std::endl <<
+                 "flow graph: \n";
+    g.print();
+    
     return 0;
 }
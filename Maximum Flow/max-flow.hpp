@@ -0,0 +1,417 @@
+//
+//  max-flow.hpp
+//
+//  Maximum flow algorithms on the residual graph in CSR form
+//  (CSR Graph/csr-graph.hpp): Edmonds-Karp, Dinic and push-relabel.
+//  All of them start from zero flow and leave the flow in g.resid.
+//
+//  Created by mkuklik on 11/15/15.
+//  Copyright © 2015 mkuklik. All rights reserved.
+//
+
+#ifndef MaxFlow_hpp
+#define MaxFlow_hpp
+
+#include <vector>
+#include <algorithm>
+#include <climits>
+
+#include "../CSR Graph/csr-graph.hpp"
+
+enum MaxFlowAlgorithm { EDMONDS_KARP, DINIC, PUSH_RELABEL };
+
+
+/*
+ *  Ford - Fulkerson algorithms
+ *  Edmonds Karp version with augmented path search using
+ *      BFS with unit edges
+ *
+ *  runs on the residual graph in CSR form, BFS state is
+ *  allocated once and reset for every augmenting path
+ */
+
+inline int edmonds_karp(CSRResidualGraph<int> &g, int start, int end)
+{
+    int N = g.n_vertices();
+    
+    // reset all flows to zero
+    g.reset();
+    
+    if (start == end) return 0;
+    
+    std::vector<int> previous(N);
+    std::vector<int> edge_to(N);    // arc leading to vertex v
+    std::vector<int> q(N);          // BFS queue, each vertex enters it at most once
+    
+    // while there exists a path p from s to t in the residual graph;
+    while (true) {
+
+        // find shortest path in residual graph using BFS under assumption
+        // that each edge has unit distance.
+        
+        // BFS BEGIN
+        
+        std::fill(previous.begin(), previous.end(), -1);
+        
+        int head {0}, tail {0};
+        q[tail++] = start;
+        previous[start] = start;
+        
+        while (head < tail && previous[end] == -1) {
+            
+            int v = q[head++];
+            
+            for (int a = g.offset[v]; a < g.offset[v+1]; a++) {
+                int to = g.target[a];
+                if (g.resid[a] > 0 && previous[to] == -1) {
+                    q[tail++] = to;
+                    
+                    previous[to] = v;
+                    edge_to[to] = a;   // save arc leading to vertex "to"
+                }
+            }
+        }
+        // BFS END
+        
+        // if (no path) break
+        if (previous[end] == -1) break;
+        
+        // finding minimum residual_capacity along the path
+        int cf {INT_MAX};
+        int i {end};
+        while (i != start) {
+            int tmp = g.resid[edge_to[i]];
+            if (tmp < cf) cf = tmp;
+            i = previous[i];
+        }
+        
+        // update graph
+        i = end;
+        while (i != start) {
+            g.push(edge_to[i], cf);     // notice that push() updates both
+            i = previous[i];            // forward and reverse arc
+        }
+    }
+    
+    // calculate maximum from the start node
+    int max_flow {0};
+    for (int a = g.offset[start]; a < g.offset[start+1]; a++)
+        if (!g.is_reverse(a))
+            max_flow += g.capacity[a] - g.resid[a];
+    
+    return max_flow;
+}
+
+
+/*
+ *  Dinic's algorithm, O(V^2 E)
+ *
+ *  1. BFS from start builds the level graph, level[v] is the
+ *     distance of v from start in the residual graph
+ *  2. blocking flow: augmenting paths are searched with DFS using only
+ *     arcs going one level up (level[to] == level[v] + 1), until
+ *     there's no such path. it[v] is current arc of v: arcs before it
+ *     are saturated or lead to dead ends and are not looked at again
+ *     in this phase, so a phase takes O(VE)
+ *  3. repeat while end is reachable, there are at most V phases
+ *     as distance to end grows in every phase
+ *
+ *  DFS is iterative, path holds arcs from start to v
+ */
+
+inline int dinic(CSRResidualGraph<int> &g, int start, int end)
+{
+    int N = g.n_vertices();
+    
+    g.reset();
+    
+    if (start == end) return 0;
+    
+    std::vector<int> level(N);
+    std::vector<int> it(N);         // current arc
+    std::vector<int> q(N);
+    std::vector<int> path;
+    
+    int max_flow {0};
+    
+    while (true) {
+        
+        // level graph
+        std::fill(level.begin(), level.end(), -1);
+        
+        int head {0}, tail {0};
+        q[tail++] = start;
+        level[start] = 0;
+        
+        while (head < tail) {
+            int v = q[head++];
+            
+            for (int a = g.offset[v]; a < g.offset[v+1]; a++) {
+                int to = g.target[a];
+                if (g.resid[a] > 0 && level[to] == -1) {
+                    level[to] = level[v] + 1;
+                    q[tail++] = to;
+                }
+            }
+        }
+        
+        if (level[end] == -1) break;
+        
+        // blocking flow
+        for (int v=0; v<N; v++)
+            it[v] = g.offset[v];
+        
+        path.clear();
+        int v {start};
+        
+        while (true) {
+            
+            if (v == end) {
+                
+                // augment along the path by its bottleneck
+                int cf {INT_MAX};
+                for (auto a : path)
+                    cf = std::min(cf, g.resid[a]);
+                
+                for (auto a : path)
+                    g.push(a, cf);
+                
+                max_flow += cf;
+                
+                // retreat to the tail of the first saturated arc
+                size_t k {0};
+                while (g.resid[path[k]] > 0) ++k;
+                
+                v = g.target[g.twin[path[k]]];
+                path.resize(k);
+                continue;
+            }
+            
+            // advance
+            int &a = it[v];
+            while (a < g.offset[v+1] &&
+                   (g.resid[a] == 0 || level[g.target[a]] != level[v] + 1))
+                ++a;
+            
+            if (a < g.offset[v+1]) {
+                
+                path.push_back(a);
+                v = g.target[a];
+            }
+            else {
+                
+                // dead end, v is removed from the level graph
+                level[v] = -1;
+                
+                if (path.empty()) break;
+                
+                v = g.target[g.twin[path.back()]];
+                path.pop_back();
+                ++it[v];
+            }
+        }
+    }
+    
+    return max_flow;
+}
+
+
+/*
+ *  Push-relabel, highest-label variant, O(V^2 sqrt(E))
+ *
+ *  Works on a preflow: vertices may hold more flow coming in than going
+ *  out (excess). Every vertex has a height; excess is pushed only
+ *  downhill, along residual arcs v->u with height[v] == height[u] + 1.
+ *  When v has excess and no such arc, v is relabeled, lifted to one
+ *  above its lowest residual neighbour. start has height N, so excess
+ *  which can't reach end climbs above N and flows back to start, at the
+ *  end preflow is a flow.
+ *
+ *  Active vertex with the highest label is discharged first.
+ *
+ *  Heuristics
+ *  - global relabeling: heights are set to exact distances to end in
+ *    the residual graph (N + distance to start for vertices which can't
+ *    reach end) with reverse BFS, at the start and after every N relabels
+ *  - gap: if no vertex is left at height h < N, vertices above h and
+ *    below N can't reach end anymore and are lifted to N+1 at once
+ */
+
+inline int push_relabel(CSRResidualGraph<int> &g, int start, int end)
+{
+    int N = g.n_vertices();
+    
+    g.reset();
+    
+    if (start == end) return 0;
+    
+    std::vector<int> excess(N, 0);
+    std::vector<int> height(N, 0);
+    std::vector<int> it(N);                     // current arc
+    std::vector<int> count(2*N + 1, 0);         // vertices at each height
+    std::vector<std::vector<int>> active(2*N + 1);  // active vertices by height
+    std::vector<int> q(N);
+    
+    int highest {0};
+    int relabels {0};
+    
+    auto activate = [&] (int v) {
+        if (v != start && v != end && excess[v] > 0) {
+            active[height[v]].push_back(v);
+            highest = std::max(highest, height[v]);
+        }
+    };
+    
+    // reverse BFS over residual arcs from root, heights start at h0
+    auto reverse_bfs = [&] (int root, int h0) {
+        int head {0}, tail {0};
+        q[tail++] = root;
+        height[root] = h0;
+        
+        while (head < tail) {
+            int v = q[head++];
+            
+            for (int a = g.offset[v]; a < g.offset[v+1]; a++) {
+                int u = g.target[a];
+                if (height[u] == -1 && g.resid[g.twin[a]] > 0) {
+                    height[u] = height[v] + 1;
+                    q[tail++] = u;
+                }
+            }
+        }
+    };
+    
+    auto global_relabel = [&] () {
+        std::fill(height.begin(), height.end(), -1);
+        
+        reverse_bfs(end, 0);
+        if (height[start] == -1)
+            reverse_bfs(start, N);
+        else
+            height[start] = N;
+        
+        std::fill(count.begin(), count.end(), 0);
+        for (auto &b : active) b.clear();
+        highest = 0;
+        
+        for (int v=0; v<N; v++) {
+            if (height[v] == -1) height[v] = 2*N;    // can't hold any excess
+            ++count[height[v]];
+            it[v] = g.offset[v];
+            activate(v);
+        }
+        
+        relabels = 0;
+    };
+    
+    // saturate all arcs leaving start
+    for (int a = g.offset[start]; a < g.offset[start+1]; a++) {
+        int f = g.resid[a];
+        if (f > 0) {
+            g.push(a, f);
+            excess[g.target[a]] += f;
+            excess[start] -= f;
+        }
+    }
+    
+    global_relabel();
+    
+    while (highest >= 0) {
+        
+        if (active[highest].empty()) {
+            --highest;
+            continue;
+        }
+        
+        int v = active[highest].back();
+        active[highest].pop_back();
+        
+        if (excess[v] == 0) continue;
+        
+        if (height[v] != highest) {
+            // height was changed by a gap, move v to its bucket
+            activate(v);
+            continue;
+        }
+        
+        // discharge v
+        while (excess[v] > 0) {
+            
+            if (it[v] == g.offset[v+1]) {
+                
+                // relabel
+                int h {2*N};
+                for (int a = g.offset[v]; a < g.offset[v+1]; a++)
+                    if (g.resid[a] > 0)
+                        h = std::min(h, height[g.target[a]] + 1);
+                
+                int old {height[v]};
+                --count[old];
+                
+                if (count[old] == 0 && old < N) {
+                    // gap
+                    for (int u=0; u<N; u++)
+                        if (height[u] > old && height[u] < N) {
+                            --count[height[u]];
+                            height[u] = N + 1;
+                            ++count[N + 1];
+                        }
+                    h = std::max(h, N + 1);
+                }
+                
+                height[v] = h;
+                ++count[h];
+                it[v] = g.offset[v];
+                
+                if (++relabels >= N) {
+                    global_relabel();   // v is put back to active there
+                    break;
+                }
+                continue;
+            }
+            
+            int a = it[v];
+            int u = g.target[a];
+            
+            if (g.resid[a] > 0 && height[v] == height[u] + 1) {
+                
+                int d = std::min(excess[v], g.resid[a]);
+                g.push(a, d);
+                
+                excess[v] -= d;
+                excess[u] += d;
+                
+                if (excess[u] == d)     // u became active
+                    activate(u);
+            }
+            
+            if (excess[v] > 0)
+                ++it[v];
+        }
+    }
+    
+    return excess[end];
+}
+
+
+/*
+ *  max_flow, maximum flow from start to end with the chosen algorithm
+ */
+
+inline int max_flow(CSRResidualGraph<int> &g, int start, int end,
+                    MaxFlowAlgorithm algorithm = DINIC)
+{
+    if (start == end) {
+        g.reset();
+        return 0;
+    }
+    
+    switch (algorithm) {
+        case EDMONDS_KARP: return edmonds_karp(g, start, end);
+        case DINIC: return dinic(g, start, end);
+        case PUSH_RELABEL: return push_relabel(g, start, end);
+    }
+    throw "max_flow: unknown algorithm";
+}
+
+#endif /* MaxFlow_hpp */
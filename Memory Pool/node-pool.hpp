@@ -0,0 +1,199 @@
+//
+//  node-pool.hpp
+//
+//  Node allocators for linked data structures (Fibonacci heap)
+//
+//  Created by mkuklik on 11/22/15.
+//  Copyright © 2015 mkuklik. All rights reserved.
+//
+
+/*
+ *  NodePool, slab allocator with a free list
+ *
+ *  Nodes are carved out of slabs, large blocks of memory holding many
+ *  nodes each, instead of one new per node. Removed nodes go to a free
+ *  list and are reused by the next create(). Each new slab is as big as
+ *  all the previous ones together, so n nodes need O(log n) allocations.
+ *
+ *  reset() releases all the nodes at once in O(1): cursor goes back to
+ *  the first slab and the free list is dropped, slabs are kept for the
+ *  next use. Destructors of the nodes are not called, that's why nodes
+ *  must be trivially destructible.
+ *
+ *  NewAllocator, one new/delete per node, nodes have to be released
+ *  one by one.
+ *
+ *  Both have the same interface:
+ *      create(args)    construct a node
+ *      destroy(n)      release one node
+ *      reserve(n)      make room for n nodes
+ *      reset()         release all nodes, only if bulk is true
+ *      absorb(other)   take over the nodes of other, used when two
+ *                      heaps are melded
+ */
+
+#ifndef NodePool_hpp
+#define NodePool_hpp
+
+#include <vector>
+#include <new>
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+
+template<typename Node>
+class NodePool {
+
+    static_assert(std::is_trivially_destructible<Node>::value,
+                  "NodePool::reset() doesn't call node destructors");
+
+    union Slot {
+        Slot * next;                                    // when on the free list
+        alignas(Node) unsigned char storage[sizeof(Node)];
+    };
+
+    std::vector<Slot *> slabs;
+    std::vector<size_t> sizes;      // number of slots in each slab
+    size_t capacity {0};            // slots in all slabs
+
+    size_t slab {0};                // slab nodes are currently taken from
+    size_t used {0};                // slots used in the current slab
+
+    Slot * free_list {nullptr};
+
+    // slabs taken over from other pools, they hold live nodes and are
+    // only given out again after reset()
+    std::vector<Slot *> adopted;
+    std::vector<size_t> adopted_sizes;
+
+    const size_t min_slab;
+
+    void grow(size_t n) {
+        slabs.push_back(static_cast<Slot *>(::operator new(n * sizeof(Slot))));
+        sizes.push_back(n);
+        capacity += n;
+    }
+
+public:
+
+    enum { bulk = true };           // reset() releases all nodes
+
+    NodePool(size_t n=256): min_slab(n) {};
+
+    NodePool(const NodePool &) = delete;
+    NodePool & operator=(const NodePool &) = delete;
+
+    ~NodePool() {
+        for (auto s : slabs)
+            ::operator delete(s);
+        for (auto s : adopted)
+            ::operator delete(s);
+    }
+
+    /*
+     *  reserve, make sure n nodes fit without further allocations
+     */
+
+    void reserve(size_t n) {
+        if (n > capacity)
+            grow(n - capacity);
+    }
+
+    template<typename... Args>
+    Node * create(Args&&... args) {
+
+        Slot * s;
+
+        if (free_list != nullptr) {
+
+            s = free_list;
+            free_list = free_list->next;
+        }
+        else {
+
+            if (slab < slabs.size() && used == sizes[slab]) {
+                ++slab;
+                used = 0;
+            }
+
+            if (slab == slabs.size())
+                grow(capacity > min_slab ? capacity : min_slab);
+
+            s = &slabs[slab][used++];
+        }
+
+        return new (s->storage) Node(std::forward<Args>(args)...);
+    }
+
+    void destroy(Node * n) {
+
+        Slot * s = reinterpret_cast<Slot *>(n);
+        s->next = free_list;
+        free_list = s;
+    }
+
+    /*
+     *  reset, release all nodes in O(1), memory is kept for reuse
+     */
+
+    void reset() {
+
+        for (size_t i=0; i<adopted.size(); i++) {
+            slabs.push_back(adopted[i]);
+            sizes.push_back(adopted_sizes[i]);
+            capacity += adopted_sizes[i];
+        }
+
+        adopted.clear();
+        adopted_sizes.clear();
+
+        slab = 0;
+        used = 0;
+        free_list = nullptr;
+    }
+
+    /*
+     *  absorb, take over all the memory of other, nodes created by other
+     *      are now released by this pool; other is left empty.
+     *      O(number of slabs); free slots of other are not reused
+     *      until reset()
+     */
+
+    void absorb(NodePool &other) {
+
+        if (&other == this) return;
+
+        adopted.insert(adopted.end(), other.slabs.begin(), other.slabs.end());
+        adopted_sizes.insert(adopted_sizes.end(), other.sizes.begin(), other.sizes.end());
+        adopted.insert(adopted.end(), other.adopted.begin(), other.adopted.end());
+        adopted_sizes.insert(adopted_sizes.end(), other.adopted_sizes.begin(),
+                             other.adopted_sizes.end());
+
+        other.slabs.clear();
+        other.sizes.clear();
+        other.adopted.clear();
+        other.adopted_sizes.clear();
+        other.capacity = 0;
+        other.reset();
+    }
+};
+
+
+template<typename Node>
+struct NewAllocator {
+
+    enum { bulk = false };          // nodes have to be released one by one
+
+    void reserve(size_t) {}
+
+    template<typename... Args>
+    Node * create(Args&&... args) { return new Node(std::forward<Args>(args)...); }
+
+    void destroy(Node * n) { delete n; }
+
+    void reset() {}
+
+    void absorb(NewAllocator &) {}
+};
+
+#endif /* NodePool_hpp */
@@ -0,0 +1,49 @@
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <random>
+
+#include "pairing-heap.hpp"
+
+/*
+ *  Pairing Heap
+ *
+ *  Created by mkuklik on 12/10/15.
+ *  Copyright © 2015 mkuklik. All rights reserved.
+ */
+
+/*
+ *  Main
+ */
+
+int main(int argc, const char * argv[]) {
+
+    typedef PairingHeap<int>::Node Node;
+
+    PairingHeap<int> h;
+
+    std::vector<int> keys(10);
+    generate(keys.begin(), keys.end(), []() -> int { return std::rand()%100; });
+
+    std::vector<Node *> nodes;
+
+    for (size_t i=0; i<keys.size(); i++) {
+        std::cout << keys[i] << " ";
+        nodes.push_back(h.insert(keys[i], (int) i));
+    }
+    std::cout << std::endl;
+
+    h.decrease_key(nodes[3], -1);
+    h.change_key(nodes[7], 1000);
+    h.remove(nodes[5]);
+
+    std::cout << "decreased " << nodes[3]->value << " to -1, increased " <<
+                 nodes[7]->value << " to 1000, removed 5" << std::endl;
+
+    while (h.size() > 0) {
+        Node * x = h.get_min_node();
+        std::cout << x->key << "(" << x->value << ") ";
+        h.remove_min();
+    }
+    std::cout << std::endl;
+}
@@ -0,0 +1,329 @@
+//
+//  pairing-heap.hpp
+//
+//  Pairing heap with the interface of FibonacciHeap
+//
+//  Created by mkuklik on 12/10/15.
+//  Copyright © 2015 mkuklik. All rights reserved.
+//
+
+/*
+ *  Pairing heap (Fredman, Sedgewick, Sleator, Tarjan 1986), a single
+ *  heap-ordered tree with any number of children per node. Children are
+ *  a doubly linked list, child points to the first one, next to the
+ *  next sibling and prev to the previous sibling or, for the first
+ *  child, to the parent. A node is three pointers besides key and
+ *  value, there's no degree, mark or parent.
+ *
+ *  merge       the root with the larger key becomes the first child of
+ *              the other one, O(1)
+ *  insert      merge with a one node tree, O(1)
+ *  decrease    cut the subtree of x out and merge it with the root, O(1)
+ *              in practice (o(log n) amortized)
+ *  remove_min  the children of the root are merged in two passes, in
+ *              pairs left to right, then the pairs right to left into
+ *              one tree, O(log n) amortized
+ *
+ *  The interface is the one of FibonacciHeap, so it can be passed to
+ *  dijkstras_heap (dijkstras-fibonacci-heap.hpp):
+ *
+ *      insert(k, v), get_min_node(), get_min_key(), remove_min(),
+ *      decrease_key(x, k), change_key(x, k), remove(x),
+ *      meld(other), insert_range(first, last), size(), reserve(n), clear()
+ *
+ *  Nodes are created by Allocator, NodePool by default (node-pool.hpp).
+ */
+
+#ifndef PairingHeap_hpp
+#define PairingHeap_hpp
+
+#include <vector>
+#include <utility>
+
+#include "../Memory Pool/node-pool.hpp"
+
+template<typename T, template<typename> class Allocator = NodePool>
+class PairingHeap {
+
+public:
+
+    struct Node {
+        int key;
+        T value;
+
+        Node * child {nullptr};     // first child
+        Node * next {nullptr};      // next sibling
+        Node * prev {nullptr};      // previous sibling, parent for the first child
+
+        Node(int k, T v): key(k), value(v) {};
+    };
+
+private:
+
+    Node * root {nullptr};
+    int N {0};
+
+    Allocator<Node> alloc;
+
+    /*
+     *  merge two roots, returns the new root
+     */
+
+    static Node * merge(Node * a, Node * b) {
+
+        if (a == nullptr) return b;
+        if (b == nullptr) return a;
+
+        if (b->key < a->key) std::swap(a, b);
+
+        b->prev = a;
+        b->next = a->child;
+        if (a->child != nullptr) a->child->prev = b;
+        a->child = b;
+
+        a->next = nullptr;
+        a->prev = nullptr;
+
+        return a;
+    }
+
+    /*
+     *  merge_pairs, two-pass merge of the sibling list starting at first
+     */
+
+    static Node * merge_pairs(Node * first) {
+
+        // pass 1, merge pairs left to right, results are pushed on a
+        // stack linked through next
+        Node * stack {nullptr};
+
+        while (first != nullptr) {
+
+            Node * a {first};
+            Node * b {a->next};
+
+            if (b == nullptr) {
+                a->next = stack;
+                stack = a;
+                break;
+            }
+
+            first = b->next;
+
+            Node * m = merge(a, b);
+            m->next = stack;
+            stack = m;
+        }
+
+        // pass 2, merge the pairs right to left
+        Node * r {stack};
+
+        if (r == nullptr) return r;
+
+        stack = r->next;
+        r->next = nullptr;
+        r->prev = nullptr;
+
+        while (stack != nullptr) {
+            Node * n {stack->next};
+            r = merge(r, stack);
+            stack = n;
+        }
+
+        return r;
+    }
+
+    /*
+     *  cut, removes the subtree of x (not the root) from its parent
+     */
+
+    static void cut(Node * x) {
+
+        if (x->prev->child == x)
+            x->prev->child = x->next;
+        else
+            x->prev->next = x->next;
+
+        if (x->next != nullptr) x->next->prev = x->prev;
+
+        x->next = nullptr;
+        x->prev = nullptr;
+    }
+
+public:
+
+    PairingHeap() {};
+
+    PairingHeap(const PairingHeap &) = delete;
+    PairingHeap & operator=(const PairingHeap &) = delete;
+
+    ~PairingHeap() {
+        if (!Allocator<Node>::bulk) clear();
+    }
+
+    Node * insert(int k, T v) {
+
+        Node * x = alloc.create(k, v);
+        root = merge(root, x);
+        ++N;
+
+        return x;
+    }
+
+    Node * get_min_node() {
+        if (root == nullptr) throw "heap is empty";
+        return root;
+    }
+
+    int get_min_key() { return get_min_node()->key; }
+
+    void remove_min() {
+
+        Node * z = get_min_node();
+
+        root = merge_pairs(z->child);
+        --N;
+
+        alloc.destroy(z);
+    }
+
+    void decrease_key(Node * x, int k) {
+
+        if (k > x->key) throw "new key is greater than current key";
+
+        x->key = k;
+
+        if (x == root) return;
+
+        cut(x);
+        root = merge(root, x);
+    }
+
+    /*
+     *  change_key, x's key goes up or down; when it goes up the children
+     *      of x are merged into the heap and x is inserted again
+     */
+
+    void change_key(Node * x, int k) {
+
+        if (x->key == k)
+            throw "k is the same as x's key; that is not a key change";
+
+        if (k < x->key) {
+            decrease_key(x, k);
+            return;
+        }
+
+        Node * c {x->child};
+        x->child = nullptr;
+
+        if (x == root)
+            root = nullptr;
+        else
+            cut(x);
+
+        x->key = k;
+        root = merge(merge(root, merge_pairs(c)), x);
+    }
+
+    /*
+     *  remove Node
+     */
+
+    void remove(Node * x) {
+
+        if (x == root) {
+            remove_min();
+            return;
+        }
+
+        cut(x);
+        root = merge(root, merge_pairs(x->child));
+        --N;
+
+        alloc.destroy(x);
+    }
+
+    /*
+     *  meld, move all nodes of other to this heap, O(1) plus handing
+     *      over other's allocator memory; other is left empty
+     */
+
+    void meld(PairingHeap &other) {
+
+        if (&other == this || other.root == nullptr) return;
+
+        alloc.absorb(other.alloc);
+
+        root = merge(root, other.root);
+        N += other.N;
+
+        other.root = nullptr;
+        other.N = 0;
+    }
+
+    /*
+     *  insert_range, inserts (key, value) pairs of [first, last) as one
+     *      sibling list merged in two passes, O(k); if nodes is given
+     *      the i-th node is stored in nodes[i]
+     */
+
+    template<typename It>
+    void insert_range(It first, It last, Node ** nodes = nullptr) {
+
+        Node * head {nullptr};
+        Node * tail {nullptr};
+
+        for (; first != last; ++first) {
+
+            Node * x = alloc.create(first->first, first->second);
+
+            if (head == nullptr)
+                head = x;
+            else
+                tail->next = x;
+            tail = x;
+
+            if (nodes != nullptr)
+                *nodes++ = x;
+
+            ++N;
+        }
+
+        root = merge(root, merge_pairs(head));
+    }
+
+    int size() const { return N; };
+
+    void reserve(int n) { alloc.reserve(n); };
+
+    /*
+     *  clear, removes all nodes; O(1) when Allocator releases them in bulk
+     */
+
+    void clear() {
+
+        if (Allocator<Node>::bulk)
+            alloc.reset();
+        else if (root != nullptr) {
+
+            std::vector<Node *> stack {root};
+
+            while (!stack.empty()) {
+
+                Node * x = stack.back();
+                stack.pop_back();
+
+                for (Node * c = x->child; c != nullptr; c = c->next)
+                    stack.push_back(c);
+
+                alloc.destroy(x);
+            }
+        }
+
+        root = nullptr;
+        N = 0;
+    }
+};
+
+#endif /* PairingHeap_hpp */
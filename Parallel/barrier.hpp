@@ -0,0 +1,51 @@
+//
+//  barrier.hpp
+//
+//  Created by mkuklik on 11/24/15.
+//  Copyright © 2015 mkuklik. All rights reserved.
+//
+
+/*
+ *  Barrier, blocks threads calling wait() until all n of them arrive.
+ *  Reusable, generation counter tells apart consecutive rounds so
+ *  a fast thread can't slip through the next wait() early.
+ */
+
+#ifndef Barrier_hpp
+#define Barrier_hpp
+
+#include <mutex>
+#include <condition_variable>
+
+class Barrier {
+
+    std::mutex m;
+    std::condition_variable cv;
+
+    const int n;            // number of threads
+    int count;              // threads still to arrive in this round
+    int generation {0};
+
+public:
+
+    Barrier(int nthreads): n(nthreads), count(nthreads) {};
+
+    void wait() {
+
+        std::unique_lock<std::mutex> lock(m);
+
+        int gen = generation;
+
+        if (--count == 0) {
+
+            // last thread to arrive opens the barrier
+            ++generation;
+            count = n;
+            cv.notify_all();
+        }
+        else
+            cv.wait(lock, [this, gen] { return gen != generation; });
+    }
+};
+
+#endif /* Barrier_hpp */
@@ -0,0 +1,49 @@
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <random>
+
+#include "radix-heap.hpp"
+
+/*
+ *  Radix Heap
+ *
+ *  Created by mkuklik on 12/9/15.
+ *  Copyright © 2015 mkuklik. All rights reserved.
+ */
+
+/*
+ *  Main
+ */
+
+int main(int argc, const char * argv[]) {
+
+    typedef RadixHeap<int>::Node Node;
+
+    RadixHeap<int> h;
+
+    std::vector<int> keys(10);
+    generate(keys.begin(), keys.end(), []() -> int { return std::rand()%100; });
+
+    std::vector<Node *> nodes;
+
+    for (size_t i=0; i<keys.size(); i++) {
+        std::cout << keys[i] << " ";
+        nodes.push_back(h.insert(keys[i], (int) i));
+    }
+    std::cout << std::endl;
+
+    // keys are never decreased below the current minimum
+    h.decrease_key(nodes[3], keys[3] / 2);
+    h.decrease_key(nodes[7], keys[7] / 2);
+
+    std::cout << "decreased " << nodes[3]->value << " to " << nodes[3]->key << ", " <<
+                 nodes[7]->value << " to " << nodes[7]->key << std::endl;
+
+    while (h.size() > 0) {
+        Node * x = h.get_min_node();
+        std::cout << x->key << "(" << x->value << ") ";
+        h.remove_min();
+    }
+    std::cout << std::endl;
+}
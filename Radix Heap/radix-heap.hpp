@@ -0,0 +1,196 @@
+//
+//  radix-heap.hpp
+//
+//  Monotone priority queue for non-negative integer keys
+//
+//  Created by mkuklik on 12/9/15.
+//  Copyright © 2015 mkuklik. All rights reserved.
+//
+
+/*
+ *  Radix heap (Ahuja, Mehlhorn, Orlin, Tarjan 1990), a priority queue
+ *  for Dijkstra's algorithm with integer weights: keys are never smaller
+ *  than the last extracted minimum, last.
+ *
+ *  Node with key k is kept in bucket
+ *
+ *      0                               if k == last
+ *      1 + index of the highest bit    where k and last differ
+ *
+ *  so bucket i holds keys which agree with last on all bits above
+ *  i-1; there are 33 buckets for 32-bit keys. All nodes of bucket 0
+ *  have the minimum key. When bucket 0 is empty, the first non-empty
+ *  bucket is scanned for its minimum, which becomes last, and its nodes
+ *  are moved to lower buckets. A node only ever moves down, at most 32
+ *  times, so extract-min is O(log C) amortized (C the largest key) and
+ *  insert and decrease_key are O(1).
+ *
+ *  The interface is the one of FibonacciHeap used by Dijkstra's
+ *  algorithm (dijkstras-fibonacci-heap.hpp), so either heap can be
+ *  passed as a template parameter:
+ *
+ *      insert(k, v), get_min_node(), remove_min(), decrease_key(x, k),
+ *      size(), reserve(n), clear()
+ *
+ *  Keys must be >= 0 and not smaller than the last minimum, anything
+ *  else throws.
+ */
+
+#ifndef RadixHeap_hpp
+#define RadixHeap_hpp
+
+#include <vector>
+
+#include "../Memory Pool/node-pool.hpp"
+
+template<typename T, template<typename> class Allocator = NodePool>
+class RadixHeap {
+
+public:
+
+    struct Node {
+        int key;
+        T value;
+
+        int bucket {0};     // bucket the node is in
+        int pos {0};        // index in the bucket
+
+        Node(int k, T v): key(k), value(v) {};
+    };
+
+private:
+
+    enum { B = 33 };
+
+    std::vector<Node *> buckets[B];
+    std::vector<Node *> scratch;    // bucket being redistributed
+
+    int last {0};                   // last extracted minimum
+    int N {0};
+
+    Allocator<Node> alloc;
+
+    int bucket_of(int k) const {
+        unsigned x = (unsigned) (k ^ last);
+        return x == 0 ? 0 : 32 - __builtin_clz(x);
+    }
+
+    void put(Node * x) {
+        x->bucket = bucket_of(x->key);
+        x->pos = (int) buckets[x->bucket].size();
+        buckets[x->bucket].push_back(x);
+    }
+
+    void take(Node * x) {
+        auto &b = buckets[x->bucket];
+        Node * y = b.back();
+        b[x->pos] = y;
+        y->pos = x->pos;
+        b.pop_back();
+    }
+
+public:
+
+    RadixHeap() {};
+
+    RadixHeap(const RadixHeap &) = delete;
+    RadixHeap & operator=(const RadixHeap &) = delete;
+
+    ~RadixHeap() {
+        if (!Allocator<Node>::bulk) clear();
+    }
+
+    Node * insert(int k, T v) {
+
+        if (k < last) throw "key is smaller than the last minimum";
+
+        Node * x = alloc.create(k, v);
+        put(x);
+        ++N;
+
+        return x;
+    }
+
+    /*
+     *  get_min_node, node with the lowest key; moves nodes between
+     *      buckets, which is why it isn't const
+     */
+
+    Node * get_min_node() {
+
+        if (N == 0) throw "heap is empty";
+
+        if (buckets[0].empty()) {
+
+            int i {1};
+            while (buckets[i].empty()) ++i;
+
+            int m {buckets[i][0]->key};
+            for (auto x : buckets[i])
+                if (x->key < m) m = x->key;
+
+            last = m;
+
+            // all nodes of bucket i go to lower buckets
+            scratch.swap(buckets[i]);
+            for (auto x : scratch)
+                put(x);
+            scratch.clear();
+        }
+
+        return buckets[0].back();
+    }
+
+    int get_min_key() { return get_min_node()->key; }
+
+    void remove_min() {
+
+        Node * x = get_min_node();
+
+        buckets[0].pop_back();
+        --N;
+
+        alloc.destroy(x);
+    }
+
+    /*
+     *  decrease_key, k must not be smaller than the last minimum
+     */
+
+    void decrease_key(Node * x, int k) {
+
+        if (k > x->key) throw "new key is greater than current key";
+        if (k < last) throw "key is smaller than the last minimum";
+
+        x->key = k;
+
+        if (bucket_of(k) != x->bucket) {
+            take(x);
+            put(x);
+        }
+    }
+
+    int size() const { return N; };
+
+    void reserve(int n) { alloc.reserve(n); };
+
+    /*
+     *  clear, remove all nodes; last goes back to 0
+     */
+
+    void clear() {
+
+        for (auto &b : buckets) {
+            if (!Allocator<Node>::bulk)
+                for (auto x : b) alloc.destroy(x);
+            b.clear();
+        }
+
+        if (Allocator<Node>::bulk) alloc.reset();
+
+        last = 0;
+        N = 0;
+    }
+};
+
+#endif /* RadixHeap_hpp */
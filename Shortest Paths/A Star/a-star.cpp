@@ -0,0 +1,57 @@
+//
+//  a-star.cpp
+//
+//  A* with ALT heuristic compared with Dijkstra's algorithm on a grid,
+//  see a-star.hpp and landmarks.hpp
+//
+//  build:
+//      g++ -std=c++11 -O2 a-star.cpp "../Dijkstras Fibonacci Heap/fibonacci-heap.cpp"
+//
+//  Created by mkuklik on 12/7/15.
+//  Copyright © 2015 mkuklik. All rights reserved.
+//
+
+#include <iostream>
+#include <vector>
+
+#include "a-star.hpp"
+#include "landmarks.hpp"
+#include "../../Benchmarks/graph-generators.hpp"
+
+using namespace std;
+
+
+int main(int argc, const char * argv[]) {
+
+    int side {200};
+
+    CSRGraph<int> g(side * side, grid(side, side, 1));
+
+    Landmarks lm(g, 16);
+
+    cout << "landmarks:";
+    for (auto l : lm.landmarks())
+        cout << " " << l;
+    cout << endl;
+
+    mt19937_64 rng(2);
+
+    for (int q=0; q<5; q++) {
+
+        int s = (int) uniform(rng, g.n_vertices());
+        int t = (int) uniform(rng, g.n_vertices());
+
+        vector<int> dist, previous;
+        size_t n_dijkstra, n_binary, n_fibonacci;
+
+        int d = astar_binary_heap(g, s, t, ZeroHeuristic(), dist, previous, &n_dijkstra);
+        int a = astar_binary_heap(g, s, t, ALTHeuristic(lm, t), dist, previous, &n_binary);
+        int f = astar_fibonacci_heap(g, s, t, ALTHeuristic(lm, t), dist, previous, &n_fibonacci);
+
+        cout << s << " -> " << t << ": distance " << d << " " << a << " " << f <<
+                ", settled dijkstra " << n_dijkstra << ", ALT " << n_binary <<
+                " (fibonacci heap " << n_fibonacci << ")" << endl;
+    }
+
+    return 0;
+}
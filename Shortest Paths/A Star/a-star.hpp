@@ -0,0 +1,171 @@
+//
+//  a-star.hpp
+//
+//  Goal directed Dijkstra's algorithm (A*) with binary and Fibonacci heap
+//
+//  Created by mkuklik on 12/7/15.
+//  Copyright © 2015 mkuklik. All rights reserved.
+//
+
+/*
+ *  A* is Dijkstra's algorithm from s where the heap key of v is
+ *
+ *      dist[v] + h(v)
+ *
+ *  and h(v) is a lower bound of the distance from v to t. Vertices in
+ *  the direction of t come out of the heap first and the search stops
+ *  when t is settled. With h = 0 this is plain Dijkstra with early stop.
+ *
+ *  The heuristic is any object with  int operator()(int v) const, it
+ *  must be consistent, h(v) <= w(v, u) + h(u) for every edge (v, u), so
+ *  a settled vertex has its final distance like in Dijkstra's algorithm.
+ *  h(v) == INT_MAX means t is not reachable from v, v is not explored.
+ *
+ *      ZeroHeuristic       h = 0
+ *      ALTHeuristic        landmarks and triangle inequality, landmarks.hpp
+ *
+ *  dist and previous are filled like in dijkstras_binary_heap for the
+ *  settled vertices. Returns distance to t, INT_MAX if not reachable;
+ *  *settled, if given, is set to the number of settled vertices.
+ */
+
+#ifndef AStar_hpp
+#define AStar_hpp
+
+#include <vector>
+#include <climits>
+
+#include "../../Binary Heap/binary-heap.hpp"
+#include "../Dijkstras Fibonacci Heap/fibonacci-heap.hpp"
+#include "../../CSR Graph/csr-graph.hpp"
+
+struct ZeroHeuristic {
+    int operator()(int) const { return 0; }
+};
+
+
+template<typename Heuristic>
+int astar_binary_heap(const CSRGraph<int> &g, int s, int t, const Heuristic &h,
+                      std::vector<int> &dist, std::vector<int> &previous,
+                      size_t * settled = nullptr) {
+
+    int n_v = g.n_vertices();
+
+    IndexedBinaryHeap<long> pq(n_v);    // keyed by dist + h, may exceed INT_MAX
+    std::vector<bool> visited(n_v, false);
+    std::vector<int> lower(n_v, -1);    // h(v), computed once per vertex
+
+    dist.assign(n_v, INT_MAX);
+    previous.assign(n_v, -1);
+
+    size_t n_settled {0};
+
+    dist[s] = 0;
+    previous[s] = s;
+    lower[s] = h(s);
+
+    if (lower[s] != INT_MAX)
+        pq.insert(s, lower[s]);
+
+    while (!pq.empty()) {
+
+        int v {pq.pop()};
+
+        visited[v] = true;
+        ++n_settled;
+
+        if (v == t) break;
+
+        for (int i = g.offset[v]; i < g.offset[v+1]; i++) {
+
+            int to {g.target[i]};
+
+            if (visited[to] || dist[to] <= dist[v] + g.value[i]) continue;
+
+            if (lower[to] < 0) lower[to] = h(to);
+            if (lower[to] == INT_MAX) continue;     // t not reachable from to
+
+            dist[to] = dist[v] + g.value[i];
+            previous[to] = v;
+
+            pq.insert_or_decrease(to, (long) dist[to] + lower[to]);
+        }
+    }
+
+    if (settled != nullptr) *settled = n_settled;
+
+    return visited[t] ? dist[t] : INT_MAX;
+}
+
+
+/*
+ *  the same with Fibonacci heap, vertices are inserted when they are
+ *      reached instead of all at the start, as most are never reached
+ */
+
+template<typename Heuristic>
+int astar_fibonacci_heap(const CSRGraph<int> &g, int s, int t, const Heuristic &h,
+                         std::vector<int> &dist, std::vector<int> &previous,
+                         size_t * settled = nullptr) {
+
+    int n_v = g.n_vertices();
+
+    FibonacciHeap<int> heap;    // keyed by dist + h, heap node stores the vertex id
+
+    typedef FibonacciHeap<int>::Node Node;
+
+    std::vector<Node *> lookup(n_v, nullptr);
+    std::vector<bool> visited(n_v, false);
+    std::vector<int> lower(n_v, -1);
+
+    dist.assign(n_v, INT_MAX);
+    previous.assign(n_v, -1);
+
+    size_t n_settled {0};
+
+    dist[s] = 0;
+    previous[s] = s;
+    lower[s] = h(s);
+
+    if (lower[s] != INT_MAX)
+        lookup[s] = heap.insert(lower[s], s);
+
+    while (heap.size() > 0) {
+
+        int v = heap.get_min_node()->value;
+
+        heap.remove_min();
+
+        visited[v] = true;
+        ++n_settled;
+
+        if (v == t) break;
+
+        for (int i = g.offset[v]; i < g.offset[v+1]; i++) {
+
+            int to {g.target[i]};
+
+            if (visited[to] || dist[to] <= dist[v] + g.value[i]) continue;
+
+            if (lower[to] < 0) lower[to] = h(to);
+            if (lower[to] == INT_MAX) continue;
+
+            dist[to] = dist[v] + g.value[i];
+            previous[to] = v;
+
+            // keys are int, dist + h is at most the length of a path to t
+            int key = dist[to] + lower[to];
+
+            if (lookup[to] == nullptr)
+                lookup[to] = heap.insert(key, to);
+            else
+                heap.decrease_key(lookup[to], key);
+        }
+    }
+
+    if (settled != nullptr) *settled = n_settled;
+
+    return visited[t] ? dist[t] : INT_MAX;
+}
+
+#endif /* AStar_hpp */
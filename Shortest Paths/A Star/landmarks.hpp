@@ -0,0 +1,171 @@
+//
+//  landmarks.hpp
+//
+//  Landmarks for ALT (A*, landmarks, triangle inequality) heuristic
+//
+//  Created by mkuklik on 12/7/15.
+//  Copyright © 2015 mkuklik. All rights reserved.
+//
+
+/*
+ *  For a landmark L and any vertices v, t the triangle inequality gives
+ *  two lower bounds of d(v, t)
+ *
+ *      d(L, t) - d(L, v)       as d(L, t) <= d(L, v) + d(v, t)
+ *      d(v, L) - d(t, L)       as d(v, L) <= d(v, t) + d(t, L)
+ *
+ *  h(v) is the largest of them over all landmarks (Goldberg, Harrelson
+ *  2005). Each bound, and so h, is consistent, A* settles every vertex
+ *  only once.
+ *
+ *  Landmarks are picked with the farthest heuristic: the first one is
+ *  the vertex farthest from a start vertex, every next one is the
+ *  vertex which is farthest from all landmarks so far. Landmarks end
+ *  up on the border of the graph, "behind" most of s, t pairs, which
+ *  is where the bounds are tight.
+ *
+ *  Distances from and to landmarks are stored vertex-major in one flat
+ *  array, the k distances of a vertex are next to each other, so h(v)
+ *  reads one or two cache lines. Memory is 2 * k * V ints.
+ */
+
+#ifndef Landmarks_hpp
+#define Landmarks_hpp
+
+#include <vector>
+#include <climits>
+#include <algorithm>
+
+#include "../Dijkstras stdlib heap/dijkstras-stdlib-heap.hpp"
+#include "../../CSR Graph/csr-graph.hpp"
+
+class Landmarks {
+
+    int N {0};
+    int K {0};
+
+    std::vector<int> ids;       // landmark vertices
+    std::vector<int> from;      // from[v*K + i] = d(L_i, v)
+    std::vector<int> to;        // to[v*K + i] = d(v, L_i)
+
+public:
+
+    /*
+     *  pick k landmarks of g and compute distance tables,
+     *      start is the vertex the farthest search starts from
+     */
+
+    Landmarks(const CSRGraph<int> &g, int k, int start = 0): N(g.n_vertices()) {
+
+        if (N == 0) return;
+
+        k = std::min(k, N);
+
+        CSRGraph<int> rev = g.reverse();
+
+        std::vector<int> dist, previous;
+        std::vector<long> nearest(N, LONG_MAX);  // distance to closest landmark
+
+        dijkstras_binary_heap(g, start, dist, previous);
+
+        for (int v=0; v<N; v++)
+            if (dist[v] != INT_MAX) nearest[v] = dist[v];
+
+        std::vector<int> d_from, d_to;      // landmark-major while building
+
+        while ((int) ids.size() < k) {
+
+            // farthest vertex reached by searches so far
+            int l {-1};
+            for (int v=0; v<N; v++)
+                if (nearest[v] != LONG_MAX && nearest[v] > 0 &&
+                    (l < 0 || nearest[v] > nearest[l]))
+                    l = v;
+
+            if (l < 0) break;   // all reachable vertices are landmarks
+
+            ids.push_back(l);
+
+            dijkstras_binary_heap(g, l, dist, previous);
+            d_from.insert(d_from.end(), dist.begin(), dist.end());
+
+            for (int v=0; v<N; v++)
+                if (dist[v] != INT_MAX) nearest[v] = std::min(nearest[v], (long) dist[v]);
+
+            nearest[l] = 0;
+
+            dijkstras_binary_heap(rev, l, dist, previous);
+            d_to.insert(d_to.end(), dist.begin(), dist.end());
+        }
+
+        K = (int) ids.size();
+
+        from.resize((size_t) N * K);
+        to.resize((size_t) N * K);
+
+        for (int i=0; i<K; i++)
+            for (int v=0; v<N; v++) {
+                from[(size_t) v*K + i] = d_from[(size_t) i*N + v];
+                to[(size_t) v*K + i] = d_to[(size_t) i*N + v];
+            }
+    }
+
+    int n_landmarks() const { return K; }
+
+    const std::vector<int> & landmarks() const { return ids; }
+
+    /*
+     *  d(L_i, v) and d(v, L_i), INT_MAX if not reachable
+     */
+
+    const int * distances_from(int v) const { return from.data() + (size_t) v*K; }
+
+    const int * distances_to(int v) const { return to.data() + (size_t) v*K; }
+};
+
+
+/*
+ *  ALTHeuristic, lower bound of distance to t from the landmarks,
+ *      INT_MAX if the tables show t can't be reached from v
+ */
+
+class ALTHeuristic {
+
+    const Landmarks &lm;
+    const int * t_from;     // d(L_i, t)
+    const int * t_to;       // d(t, L_i)
+
+public:
+
+    ALTHeuristic(const Landmarks &landmarks, int t): lm(landmarks),
+        t_from(landmarks.distances_from(t)), t_to(landmarks.distances_to(t)) {};
+
+    int operator()(int v) const {
+
+        const int * v_from = lm.distances_from(v);
+        const int * v_to = lm.distances_to(v);
+
+        int h {0};
+
+        for (int i=0; i<lm.n_landmarks(); i++) {
+
+            if (t_from[i] != INT_MAX) {
+                if (v_from[i] != INT_MAX)
+                    h = std::max(h, t_from[i] - v_from[i]);
+            }
+            else if (v_from[i] != INT_MAX)
+                return INT_MAX;     // L reaches v but not t, so v doesn't reach t
+
+            if (t_to[i] != INT_MAX) {
+                if (v_to[i] != INT_MAX)
+                    h = std::max(h, v_to[i] - t_to[i]);
+                else
+                    return INT_MAX; // t reaches L but v doesn't, so v doesn't reach t
+            }
+        }
+
+        return h;
+    }
+};
+
+#endif /* Landmarks_hpp */
@@ -59,193 +59,10 @@
 
 
 #include <iostream>
-#include <vector>
-#include <stack>
-
-using namespace std;
-
-/*
- *
- */
-
-template<typename T>
-struct Graph {
-    
-    struct Edge {
-        T value;
-        int from;
-        int to;
-        Edge* next{nullptr};
-        
-        Edge(int f, int t, int v, Edge* n=nullptr): from(f), to(t), value(v), next(n) {};
-    };
-    
-    const int N; // number of vertecies
-    
-    vector<Edge *> vertex;  //link vertex to first edge in linked-list
-    vector<Edge *> edges;
-    
-    Graph(int n): vertex(vector<Edge *>(n, nullptr)), N(n) {};
-    ~Graph();
-    
-    int add(int f, int t, T value);
-    const int nvertex() const { return N; }
-    void print();
-};
-
-template<typename T>
-Graph<T>::~Graph() {
-    // deallocate all existing edges
-    for (int i=0; i<N; i++) {
-        Edge *e {vertex[i]};
-        while (e != nullptr) {
-            Edge *tmp {e->next};
-            delete e;
-            e = tmp;
-        }
-    }
-}
-
-/*
- *  Add edge
- */
-
-template<typename T>
-int Graph<T>::add(int f, int t, T v) {
-    Edge *e = new Edge(f, t, v);
-    
-    if (vertex[f] == nullptr) {
-        vertex[f] = e;
-    } else {
-        Edge *n {vertex[f]};
-        
-        // find last Edge in the linked list
-        while (n->next != nullptr)
-            n = n->next;
-        n->next = e;
-    }
-    
-    // get edge id and return it to client
-    edges.push_back(e);
-    return (int) edges.size() - 1;
-}
-
-/*
- *  Print graph
- */
-
-template<typename T>
-void Graph<T>::print() {
-    cout << endl;
-    
-    for (int i=0; i<N; i++) {
-        cout << i << ": ";
-        
-        Edge *e {vertex[i]};
-        while (e != nullptr) {
-            cout << e->to << " (" << e->value << ")  ";
-            e = e->next;
-        }
-        cout << endl;
-    }
-}
-    
-
-/*
- *  BellmanFord single-source Shortest Path algorithm
- */
-
-
-class BellmanFord {
-
-    const int N;
-    const Graph<int> &g;
-    
-    vector<int> dist;
-    vector<int> prev;
-    
-    int start;
-    bool noNegativeCycles {true};
-    
-public:
-    BellmanFord(const Graph<int> &gg):  N(gg.nvertex()), g(gg), dist(vector<int>(N, 0)),
-                                 prev(vector<int>(N, -1)) {};
-    
-    /*
-     *  shortest Paths from s
-     */
-    
-    bool shortestPathFrom(int s) {
-        
-        start = s;
-        
-        for (int i=0; i<N; i++) {
-            
-            dist[i] = INT_MAX;
-            prev[i] = -1;
-        }
-        
-        dist[s] = 0;
-        prev[s] = s;
-        
-        for (int i=0; i<N-1; i++) {
-            
-            // loop over all edges
-            for (auto e: g.edges) {    // or (Graph<int>::Edge *e: g.edges)
-                if (dist[e->from] == INT_MAX) continue;
-                
-                // relax an edge
-                if (dist[e->from] + e->value < dist[e->to]) {
-                    
-                    dist[e->to] = dist[e->from] + e->value;
-                    prev[e->to] = e->from;
-                }
-            }
-        }
-        
-        // detect cycles
-        for (auto e: g.edges) {
-            
-            if (dist[e->from] + e->value < dist[e->to]) {
-                noNegativeCycles = false;
-                return false;
-            }
-        }
-        return true;
-    }
-    
-    /*
-     *  Print results
-     */
-    
-    void print() {
-        if (!noNegativeCycles) {
-    
-            std::cout << "negative cycles detected\n";
-        }
-        else {
-            cout << "starting from " << start << endl;
-
-            for (int i=0; i<N; i++) {
-                
-                cout << i << " d(" << dist[i] << ")";
-                int p {i};
-    
-                while (p != start) {
-                    cout << " <- " << prev[p];
-                    p = prev[p];
-                }
-                
-                std::cout << std::endl;
-            }
-        }
-
-    }
-    
-};
-
 
+#include "bellman-ford.hpp"
 
+using namespace std;
 
 
 int main(int argc, const char * argv[]) {
@@ -0,0 +1,665 @@
+//
+//  bellman-ford.hpp
+//
+//  Created by mkuklik on 11/11/15.
+//  Copyright © 2015 mkuklik. All rights reserved.
+//
+
+#ifndef BellmanFord_hpp
+#define BellmanFord_hpp
+
+#include <iostream>
+#include <vector>
+#include <stack>
+#include <climits>
+#include <algorithm>
+#include <utility>
+#include <atomic>
+#include <thread>
+
+#include "../../CSR Graph/csr-graph.hpp"
+#include "../../Parallel/barrier.hpp"
+#include "edge-arrays.hpp"
+
+
+/*
+ *
+ */
+
+template<typename T>
+struct Graph {
+    
+    struct Edge {
+        T value;
+        int from;
+        int to;
+        Edge* next{nullptr};
+        
+        Edge(int f, int t, int v, Edge* n=nullptr): from(f), to(t), value(v), next(n) {};
+    };
+    
+    const int N; // number of vertecies
+    
+    std::vector<Edge *> vertex;  //link vertex to first edge in linked-list
+    std::vector<Edge *> edges;
+    
+    Graph(int n): vertex(std::vector<Edge *>(n, nullptr)), N(n) {};
+    ~Graph();
+    
+    int add(int f, int t, T value);
+    const int nvertex() const { return N; }
+    CSRGraph<T> csr() const;
+    void print();
+};
+
+template<typename T>
+Graph<T>::~Graph() {
+    // deallocate all existing edges
+    for (int i=0; i<N; i++) {
+        Edge *e {vertex[i]};
+        while (e != nullptr) {
+            Edge *tmp {e->next};
+            delete e;
+            e = tmp;
+        }
+    }
+}
+
+/*
+ *  Add edge
+ */
+
+template<typename T>
+int Graph<T>::add(int f, int t, T v) {
+    Edge *e = new Edge(f, t, v);
+    
+    if (vertex[f] == nullptr) {
+        vertex[f] = e;
+    } else {
+        Edge *n {vertex[f]};
+        
+        // find last Edge in the linked list
+        while (n->next != nullptr)
+            n = n->next;
+        n->next = e;
+    }
+    
+    // get edge id and return it to client
+    edges.push_back(e);
+    return (int) edges.size() - 1;
+}
+
+/*
+ *  CSR copy of the graph, edges of a vertex keep insertion order
+ */
+
+template<typename T>
+CSRGraph<T> Graph<T>::csr() const {
+    typename CSRGraph<T>::Builder b(N, edges.size());
+    
+    for (auto e: edges)
+        b.add(e->from, e->to, e->value);
+    
+    return b.build();
+}
+
+/*
+ *  Print graph
+ */
+
+template<typename T>
+void Graph<T>::print() {
+    std::cout << std::endl;
+    
+    for (int i=0; i<N; i++) {
+        std::cout << i << ": ";
+        
+        Edge *e {vertex[i]};
+        while (e != nullptr) {
+            std::cout << e->to << " (" << e->value << ")  ";
+            e = e->next;
+        }
+        std::cout << std::endl;
+    }
+}
+    
+
+/*
+ *  BellmanFord single-source Shortest Path algorithm
+ *
+ *  EDGE_PASSES  up to N passes over all edges, stops after a pass
+ *               which didn't change anything or left a cycle in the
+ *               parent graph
+ *  SPFA         queue of vertices whose distance changed, only their
+ *               edges are relaxed; near-linear when most weights are
+ *               positive, O(VE) at worst
+ *  PARALLEL     passes split between threads, see parallelPasses
+ *  EDGE_ARRAYS  passes over EdgeArrays, eight edges at a time with
+ *               AVX2 (edge-arrays.hpp)
+ *
+ *  A negative cycle reachable from the sources is returned by
+ *  negative_cycle(), as a sequence of vertices, with its weight.
+ */
+
+enum BellmanFordMethod { EDGE_PASSES, SPFA, PARALLEL, EDGE_ARRAYS };
+
+class BellmanFord {
+
+    const int N;
+    
+    CSRGraph<int> own;          // CSR copy when constructed from linked-list Graph
+    const CSRGraph<int> &g;
+    
+    std::vector<int> dist;
+    std::vector<int> prev;
+    std::vector<int> orig;      // source the path to a vertex starts at
+    
+    std::vector<int> start;
+    bool noNegativeCycles {true};
+    
+    std::vector<int> queue;     // SPFA, ring buffer, a vertex is in it at most once
+    std::vector<char> inQueue;
+    std::vector<int> mark;      // parentCycle, walk a vertex was reached in
+    
+    CSRGraph<int> rev;          // PARALLEL, in-edges of every vertex
+    EdgeArrays edges;           // EDGE_ARRAYS
+    
+    std::vector<int> cycle;     // negative cycle, cycle[i] -> cycle[i+1] -> ... -> cycle[0]
+    long long cycleWeight {0};
+    
+    /*
+     *  edgePasses, relax all edges until nothing changes. A pass which
+     *  changed something is followed by a walk-to-root check of the
+     *  parent graph, O(N), so a negative cycle usually stops it long
+     *  before N-1 passes. Without negative cycles pass N-1 is the last
+     *  to change anything; with one, pass N changes something too and
+     *  leaves a cycle in the parent graph.
+     */
+    
+    bool edgePasses() {
+        
+        for (int i=0; i<N; i++) {
+            
+            bool changed {false};
+            
+            // loop over all edges, grouped by the start vertex
+            for (int u=0; u<N; u++) {
+                if (dist[u] == INT_MAX) continue;
+                
+                for (int j=g.offset[u]; j<g.offset[u+1]; j++) {
+                    int to {g.target[j]};
+                    
+                    // relax an edge
+                    if (dist[u] + g.value[j] < dist[to]) {
+                        
+                        if (to == u) return negativeLoop(u);
+                        
+                        dist[to] = dist[u] + g.value[j];
+                        prev[to] = u;
+                        orig[to] = orig[u];
+                        changed = true;
+                    }
+                }
+            }
+            
+            // fixed point, no edge can be relaxed and there's no
+            // negative cycle to find
+            if (!changed) return true;
+            
+            int x = parentCycle();
+            if (x >= 0) return negativeCycle(x);
+        }
+        
+        // only for N == 0, pass N can't change anything without a cycle
+        return N == 0;
+    }
+    
+    /*
+     *  edgeArrayPasses, edgePasses with relax_pass; a negative loop at a
+     *  reached vertex is a cycle
+     */
+    
+    bool edgeArrayPasses() {
+        
+        if (edges.N != N) edges = EdgeArrays(g);
+        
+        for (int i=0; i<N; i++) {
+            
+            bool changed = relax_pass(edges, dist.data(), prev.data(), orig.data());
+            
+            for (auto v : edges.loops)
+                if (dist[v] != INT_MAX) return negativeLoop(v);
+            
+            if (!changed) return true;
+            
+            int x = parentCycle();
+            if (x >= 0) return negativeCycle(x);
+        }
+        
+        // as in parallelPasses
+        return N == 0 || edgePasses();
+    }
+    
+    /*
+     *  parallelPasses, Jacobi-style passes: every vertex takes the
+     *  minimum over its in-edges of distances from the previous pass.
+     *  Threads take chunks of vertices from a shared counter and keep
+     *  the new distances, after a barrier each writes its own to dist,
+     *  so there's no locking or atomics on dist and prev. Only vertices
+     *  with an in-edge from one which changed in the last pass are
+     *  looked at, the others can't change.
+     *
+     *  Results don't depend on the number of threads or their timing.
+     *  dist is the same as serial; prev too when shortest paths are
+     *  unique, on ties prev[v] is the first of v's in-edges, in
+     *  insertion order, that gave the distance in the earliest pass.
+     *
+     *  After a pass which changed something the parent graph is checked
+     *  for a cycle, as in edgePasses. orig is filled in at the end from
+     *  prev.
+     */
+    
+    bool parallelPasses(int n_threads) {
+        
+        if (n_threads <= 0)
+            n_threads = std::max(1u, std::thread::hardware_concurrency());
+        
+        const int CHUNK = 256;              // vertices taken at once
+        
+        if (rev.n_vertices() != N) rev = g.reverse();
+        
+        // active[p % 2][v], v is looked at in pass p
+        std::vector<std::atomic<char>> active[2] {std::vector<std::atomic<char>>(N),
+                                                  std::vector<std::atomic<char>>(N)};
+        
+        for (int v=0; v<N; v++) {
+            active[0][v].store(0, std::memory_order_relaxed);
+            active[1][v].store(0, std::memory_order_relaxed);
+        }
+        
+        for (int s=0; s<N; s++)
+            if (prev[s] == s)
+                for (int j=g.offset[s]; j<g.offset[s+1]; j++)
+                    active[0][g.target[j]].store(1, std::memory_order_relaxed);
+        
+        std::atomic<int> cursor {0};
+        std::atomic<bool> changed {false};
+        std::atomic<int> loop {INT_MAX};    // lowest vertex with a negative loop
+        
+        bool done {false};
+        bool result {true};
+        int pass {0};
+        
+        Barrier barrier(n_threads);
+        
+        auto worker = [&] (int t) {
+            
+            std::vector<std::pair<int, int>> improved;     // (v, new dist[v])
+            
+            while (true) {
+                
+                std::vector<std::atomic<char>> &now = active[pass % 2];
+                std::vector<std::atomic<char>> &then = active[(pass + 1) % 2];
+                
+                int k;
+                
+                while ((k = cursor.fetch_add(CHUNK)) < N) {
+                    
+                    int last = std::min(k + CHUNK, N);
+                    
+                    for (int v=k; v<last; v++) {
+                        
+                        if (!now[v].load(std::memory_order_relaxed)) continue;
+                        now[v].store(0, std::memory_order_relaxed);
+                        
+                        int best {dist[v]};
+                        int p {prev[v]};
+                        
+                        for (int j=rev.offset[v]; j<rev.offset[v+1]; j++) {
+                            int u {rev.target[j]};
+                            if (dist[u] == INT_MAX) continue;
+                            
+                            if (dist[u] + rev.value[j] < best) {
+                                best = dist[u] + rev.value[j];
+                                p = u;
+                            }
+                        }
+                        
+                        if (best < dist[v]) {
+                            prev[v] = p;
+                            improved.push_back(std::make_pair(v, best));
+                            
+                            if (p == v) {
+                                int l = loop.load();
+                                while (v < l && !loop.compare_exchange_weak(l, v));
+                            }
+                        }
+                    }
+                }
+                
+                if (!improved.empty()) changed.store(true);
+                
+                barrier.wait();
+                
+                for (auto &x : improved) {
+                    dist[x.first] = x.second;
+                    
+                    for (int j=g.offset[x.first]; j<g.offset[x.first+1]; j++)
+                        then[g.target[j]].store(1, std::memory_order_relaxed);
+                }
+                improved.clear();
+                
+                // thread 0 looks at the pass (prev only) and sets up the next one
+                if (t == 0) {
+                    
+                    if (loop.load() != INT_MAX) {
+                        result = negativeLoop(loop.load());
+                        done = true;
+                    }
+                    else if (!changed.load())
+                        done = true;
+                    else {
+                        int x = parentCycle();
+                        
+                        if (x >= 0) {
+                            result = negativeCycle(x);
+                            done = true;
+                        }
+                        else if (++pass == N)
+                            done = true;
+                    }
+                    
+                    cursor.store(0);
+                    changed.store(false);
+                }
+                
+                barrier.wait();
+                
+                if (done) break;
+            }
+        };
+        
+        std::vector<std::thread> threads;
+        for (int t=1; t<n_threads; t++)
+            threads.push_back(std::thread(worker, t));
+        
+        worker(0);
+        
+        for (auto &th : threads)
+            th.join();
+        
+        if (!result) return false;
+        
+        fillOrigins();
+        
+        // N passes without a cycle in the parent graph showing up,
+        // edgePasses goes on from here until it does
+        return pass < N || edgePasses();
+    }
+    
+    /*
+     *  fillOrigins, orig from prev, sources are the vertices with
+     *  prev[s] == s
+     */
+    
+    void fillOrigins() {
+        
+        std::vector<int> path;
+        
+        for (int v=0; v<N; v++)
+            orig[v] = prev[v] == v ? v : -1;
+        
+        for (int v=0; v<N; v++) {
+            
+            int x {v};
+            while (prev[x] >= 0 && orig[x] < 0) {
+                path.push_back(x);
+                x = prev[x];
+            }
+            
+            for (auto y : path) orig[y] = orig[x];
+            path.clear();
+        }
+    }
+    
+    /*
+     *  spfa, relax edges of vertices taken from a FIFO queue; a vertex is
+     *  queued when its distance goes down. Parent checking: a vertex whose
+     *  parent is still in the queue is skipped, its distance is going to
+     *  go down again when the parent is scanned.
+     *
+     *  Every N relaxations the parent graph (prev) is checked for a cycle;
+     *  with strict relaxations such a cycle is always negative, and with
+     *  a negative cycle reachable one shows up after finitely many
+     *  relaxations (Cherkassky, Goldberg 1999). The check is O(N), so it
+     *  adds O(1) per relaxation.
+     */
+    
+    bool spfa() {
+        
+        queue.resize(N);
+        inQueue.assign(N, 0);
+        
+        int head {0}, count {0};
+        
+        for (int s=0; s<N; s++)
+            if (prev[s] == s) {
+                queue[count++] = s;
+                inQueue[s] = 1;
+            }
+        
+        long relaxed {0};
+        
+        while (count > 0) {
+            
+            int u {queue[head]};
+            head = head + 1 == N ? 0 : head + 1;
+            --count;
+            inQueue[u] = 0;
+            
+            if (prev[u] != u && inQueue[prev[u]]) continue;
+            
+            for (int j=g.offset[u]; j<g.offset[u+1]; j++) {
+                int to {g.target[j]};
+                int d {dist[u] + g.value[j]};
+                
+                if (d < dist[to]) {
+                    
+                    if (to == u) return negativeLoop(u);
+                    
+                    dist[to] = d;
+                    prev[to] = u;
+                    orig[to] = orig[u];
+                    
+                    if (!inQueue[to]) {
+                        int tail {head + count};
+                        queue[tail >= N ? tail - N : tail] = to;
+                        ++count;
+                        inQueue[to] = 1;
+                    }
+                    
+                    if (++relaxed == N) {
+                        relaxed = 0;
+                        int x = parentCycle();
+                        if (x >= 0) return negativeCycle(x);
+                    }
+                }
+            }
+        }
+        return true;
+    }
+    
+    /*
+     *  parentCycle, a vertex on a cycle of prev pointers, -1 if there's
+     *  none; every vertex is visited once, walks stop at a source
+     *  (prev[s] == s) or at a vertex seen in an earlier walk
+     */
+    
+    int parentCycle() {
+        
+        mark.assign(N, -1);
+        
+        for (int v=0; v<N; v++) {
+            if (prev[v] < 0 || mark[v] >= 0) continue;
+            
+            int x {v};
+            while (mark[x] < 0) {
+                mark[x] = v;
+                if (prev[x] == x) break;
+                x = prev[x];
+            }
+            
+            if (mark[x] == v && prev[x] != x) return x;
+        }
+        return -1;
+    }
+    
+    /*
+     *  negativeCycle, stores the cycle of prev pointers through x, in
+     *  edge order, and its weight; returns false. Parallel edges count
+     *  with the lowest weight, the cycle is still negative.
+     */
+    
+    bool negativeCycle(int x) {
+        
+        cycle.clear();
+        
+        int v {x};
+        do {
+            cycle.push_back(v);
+            v = prev[v];
+        } while (v != x);
+        
+        std::reverse(cycle.begin(), cycle.end());
+        
+        cycleWeight = 0;
+        for (size_t i=0; i<cycle.size(); i++) {
+            int u {cycle[i]};
+            int to {cycle[(i + 1) % cycle.size()]};
+            
+            int w {INT_MAX};
+            for (int j=g.offset[u]; j<g.offset[u+1]; j++)
+                if (g.target[j] == to && g.value[j] < w) w = g.value[j];
+            
+            cycleWeight += w;
+        }
+        return false;
+    }
+    
+    /*
+     *  negativeLoop, edge u -> u with negative weight; prev[u] == u
+     *  would make u look like a source to parentCycle
+     */
+    
+    bool negativeLoop(int u) {
+        prev[u] = u;
+        return negativeCycle(u);
+    }
+    
+public:
+    BellmanFord(const CSRGraph<int> &gg):  N(gg.n_vertices()), g(gg), dist(std::vector<int>(N, 0)),
+                                 prev(std::vector<int>(N, -1)), orig(std::vector<int>(N, -1)) {};
+    
+    BellmanFord(const Graph<int> &gg):  N(gg.nvertex()), own(gg.csr()), g(own),
+                                 dist(std::vector<int>(N, 0)), prev(std::vector<int>(N, -1)),
+                                 orig(std::vector<int>(N, -1)) {};
+    
+    /*
+     *  shortest Paths from s; n_threads is for PARALLEL, 0 uses all cores
+     */
+    
+    bool shortestPathFrom(int s, BellmanFordMethod method = EDGE_PASSES, int n_threads = 0) {
+        return shortestPathFrom(std::vector<int> {s}, method, n_threads);
+    }
+    
+    /*
+     *  shortest Paths from the nearest of sources, as from a super-source
+     *  with zero weight edges to all of them; origins()[v] is the source
+     *  v's path starts at; false if there's a negative cycle reachable
+     *  from them
+     */
+    
+    bool shortestPathFrom(const std::vector<int> &sources,
+                          BellmanFordMethod method = EDGE_PASSES, int n_threads = 0) {
+        
+        start = sources;
+        noNegativeCycles = true;
+        cycle.clear();
+        cycleWeight = 0;
+        
+        for (int i=0; i<N; i++) {
+            
+            dist[i] = INT_MAX;
+            prev[i] = -1;
+            orig[i] = -1;
+        }
+        
+        for (auto s : sources) {
+            
+            if (s < 0 || s >= N) throw "BellmanFord: source out of range";
+            
+            dist[s] = 0;
+            prev[s] = s;
+            orig[s] = s;
+        }
+        
+        switch (method) {
+            case SPFA: noNegativeCycles = spfa(); break;
+            case PARALLEL: noNegativeCycles = parallelPasses(n_threads); break;
+            case EDGE_ARRAYS: noNegativeCycles = edgeArrayPasses(); break;
+            default: noNegativeCycles = edgePasses();
+        }
+        return noNegativeCycles;
+    }
+    
+    const std::vector<int> & distances() const { return dist; }
+    const std::vector<int> & previous() const { return prev; }
+    const std::vector<int> & origins() const { return orig; }
+    bool no_negative_cycles() const { return noNegativeCycles; }
+    
+    /*
+     *  negative cycle found by the last shortestPathFrom, empty if there
+     *  was none; its edges are cycle[i] -> cycle[i+1] and back to cycle[0]
+     */
+    
+    const std::vector<int> & negative_cycle() const { return cycle; }
+    long long negative_cycle_weight() const { return cycleWeight; }
+    
+    /*
+     *  Print results
+     */
+    
+    void print() {
+        if (!noNegativeCycles) {
+    
+            std::cout << "negative cycles detected\n";
+            
+            if (!cycle.empty()) {
+                for (auto v : cycle) std::cout << v << " -> ";
+                std::cout << cycle[0] << " (" << cycleWeight << ")\n";
+            }
+        }
+        else {
+            std::cout << "starting from";
+            for (auto s : start) std::cout << " " << s;
+            std::cout << std::endl;
+
+            for (int i=0; i<N; i++) {
+                
+                std::cout << i << " d(" << dist[i] << ")";
+                int p {i};
+    
+                while (p >= 0 && prev[p] != p) {
+                    std::cout << " <- " << prev[p];
+                    p = prev[p];
+                }
+                
+                std::cout << std::endl;
+            }
+        }
+
+    }
+    
+};
+
+#endif /* BellmanFord_hpp */
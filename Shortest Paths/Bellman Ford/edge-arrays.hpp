@@ -0,0 +1,159 @@
+//
+//  edge-arrays.hpp
+//
+//  Edge list as three arrays, relaxation pass with AVX2
+//
+//  Created by mkuklik on 12/13/15.
+//  Copyright © 2015 mkuklik. All rights reserved.
+//
+
+/*
+ *  EdgeArrays, edges of a graph as from[i], to[i], w[i], in CSR order:
+ *  sorted by source, edges of a source in insertion order. Reads of
+ *  dist[from] go through dist front to back and the edges of a vertex
+ *  are next to each other. Self-loops are left out, the vertices with
+ *  a negative one are in loops.
+ *
+ *  relax_pass, one Bellman-Ford pass over all edges, in place. With
+ *  AVX2 (-mavx2) eight edges at a time: dist[from] and dist[to] are
+ *  gathered, the weights added and compared, and only the edges which
+ *  improve something are relaxed, one by one in order, checked again
+ *  against current distances. Most edges don't improve anything after
+ *  the first few passes, so most groups end after the compare. Without
+ *  AVX2 it's the same loop in plain C++.
+ *
+ *  A relaxation can lower dist[from] of another edge of the group,
+ *  which was compared with the old distance, so a group which relaxed
+ *  something is compared again (edges of a vertex and its neighbour
+ *  are often in one group, e.g. on grids); without that improvements
+ *  move one group per pass.
+ */
+
+#ifndef EdgeArrays_hpp
+#define EdgeArrays_hpp
+
+#include <vector>
+#include <climits>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+#include "../../CSR Graph/csr-graph.hpp"
+
+struct EdgeArrays {
+
+    int N {0};                  // number of vertices
+
+    std::vector<int> from;
+    std::vector<int> to;
+    std::vector<int> w;
+
+    std::vector<int> loops;     // vertices with a negative self-loop
+
+    EdgeArrays() {};
+
+    EdgeArrays(const CSRGraph<int> &g): N(g.n_vertices()) {
+
+        from.reserve(g.n_edges());
+        to.reserve(g.n_edges());
+        w.reserve(g.n_edges());
+
+        for (int u=0; u<N; u++) {
+
+            bool loop {false};
+
+            for (int j=g.offset[u]; j<g.offset[u+1]; j++) {
+
+                if (g.target[j] == u) {
+                    loop = loop || g.value[j] < 0;
+                    continue;
+                }
+
+                from.push_back(u);
+                to.push_back(g.target[j]);
+                w.push_back(g.value[j]);
+            }
+
+            if (loop) loops.push_back(u);
+        }
+    }
+
+    size_t size() const { return from.size(); }
+};
+
+namespace edge_arrays {
+
+    /*
+     *  relax edge i, returns true if dist[to] went down
+     */
+
+    inline bool relax(const EdgeArrays &e, size_t i, int * dist, int * prev, int * orig) {
+
+        int u {e.from[i]};
+        if (dist[u] == INT_MAX) return false;
+
+        int v {e.to[i]};
+        int d {dist[u] + e.w[i]};
+
+        if (d >= dist[v]) return false;
+
+        dist[v] = d;
+        prev[v] = u;
+        orig[v] = orig[u];
+
+        return true;
+    }
+}
+
+/*
+ *  relax_pass, relax all edges once, returns true if any distance
+ *      went down; INT_MAX is infinity
+ */
+
+inline bool relax_pass(const EdgeArrays &e, int * dist, int * prev, int * orig) {
+
+    bool changed {false};
+    size_t i {0};
+    size_t m {e.size()};
+
+#ifdef __AVX2__
+    const __m256i inf = _mm256_set1_epi32(INT_MAX);
+
+    for (; i + 8 <= m; i += 8) {
+
+        __m256i f = _mm256_loadu_si256((const __m256i *) &e.from[i]);
+        __m256i t = _mm256_loadu_si256((const __m256i *) &e.to[i]);
+        __m256i w = _mm256_loadu_si256((const __m256i *) &e.w[i]);
+
+        // a chain of edges in the group is at most 8 long
+        for (int round=0; round<8; round++) {
+
+            __m256i df = _mm256_i32gather_epi32(dist, f, 4);
+            __m256i dt = _mm256_i32gather_epi32(dist, t, 4);
+
+            // dist[from] + w < dist[to], unless dist[from] is infinity
+            __m256i better = _mm256_cmpgt_epi32(dt, _mm256_add_epi32(df, w));
+            better = _mm256_andnot_si256(_mm256_cmpeq_epi32(df, inf), better);
+
+            unsigned mask = (unsigned) _mm256_movemask_ps(_mm256_castsi256_ps(better));
+
+            bool relaxed {false};
+            while (mask != 0) {
+                relaxed |= edge_arrays::relax(e, i + __builtin_ctz(mask), dist, prev, orig);
+                mask &= mask - 1;
+            }
+
+            if (!relaxed) break;
+            changed = true;
+        }
+    }
+#endif
+
+    for (; i < m; i++)
+        changed |= edge_arrays::relax(e, i, dist, prev, orig);
+
+    return changed;
+}
+
+#endif /* EdgeArrays_hpp */
@@ -0,0 +1,237 @@
+//
+//  ch-query.hpp
+//
+//  Point to point queries on a contraction hierarchy
+//
+//  Created by mkuklik on 12/8/15.
+//  Copyright © 2015 mkuklik. All rights reserved.
+//
+
+/*
+ *  Bidirectional Dijkstra's search, forward from s over the up arcs
+ *  and backward from t over the down arcs, so both searches only go to
+ *  vertices of higher rank. Every shortest path has a vertex of the
+ *  highest rank, where the two searches meet. mu is the best
+ *  df[v] + db[v] over vertices reached by both; a side stops when the
+ *  top of its heap is not smaller than mu, as every path it could
+ *  still find would be longer.
+ *
+ *  Stall on demand (Geisberger et al.): a vertex v settled by the
+ *  forward search is not expanded if a down arc u->v from an already
+ *  reached u gives a shorter distance than dist[v]; dist[v] is not the
+ *  real distance, so v can't be on a shortest path. The same for the
+ *  backward search with up arcs. Most of the settled vertices of a
+ *  plain search are stalled and their arcs are never scanned.
+ *
+ *  Unlike bidirectional-dijkstra.hpp a search can't stop as soon as
+ *  the two heap tops add up to mu, because the meeting vertex is the
+ *  top of the hierarchy and not in the middle of the path.
+ *
+ *  path() unpacks the shortcuts on the s-meet-t path to original edges,
+ *  previous() gives the same previous chain as dijkstras_binary_heap
+ *  for the vertices of that path.
+ *
+ *  Buffers are reused with generation stamps, one CHQuery per thread.
+ */
+
+#ifndef CHQuery_hpp
+#define CHQuery_hpp
+
+#include <vector>
+#include <climits>
+#include <cstdint>
+#include <algorithm>
+
+#include "contraction-hierarchy.hpp"
+
+class CHQuery {
+
+    struct Side {
+
+        const CSRGraph<Shortcut> &g;        // arcs the search follows
+        const CSRGraph<Shortcut> &other;    // arcs into vertices, for stalling
+
+        IndexedBinaryHeap<long> pq;
+
+        std::vector<long> dist;
+        std::vector<int> prev;      // vertex the arc came from
+        std::vector<int> arc;       // index of the arc in g
+        std::vector<uint32_t> reached;
+
+        bool stopped {false};
+
+        Side(const CSRGraph<Shortcut> &graph, const CSRGraph<Shortcut> &opposite):
+            g(graph), other(opposite), pq(graph.n_vertices()),
+            dist(graph.n_vertices()), prev(graph.n_vertices()), arc(graph.n_vertices()),
+            reached(graph.n_vertices(), 0) {};
+    };
+
+    const ContractionHierarchy &ch;
+
+    Side fwd;
+    Side bwd;
+
+    uint32_t gen {0};
+    int s {-1};
+    int t {-1};
+    int meet {-1};
+    long mu {LONG_MAX};
+    size_t n_settled {0};
+
+    void step(Side &a, const Side &other) {
+
+        int v {a.pq.pop()};
+        ++n_settled;
+
+        if (other.reached[v] == gen && a.dist[v] + other.dist[v] < mu) {
+            mu = a.dist[v] + other.dist[v];
+            meet = v;
+        }
+
+        // stall on demand, v is reached through a higher vertex u by a
+        // shorter path than the current one, so nothing found from v
+        // can be on a shortest path
+        for (int i = a.other.offset[v]; i < a.other.offset[v+1]; i++) {
+            int u {a.other.target[i]};
+            if (a.reached[u] == gen && a.dist[u] + a.other.value[i].weight < a.dist[v])
+                return;
+        }
+
+        for (int i = a.g.offset[v]; i < a.g.offset[v+1]; i++) {
+
+            int to {a.g.target[i]};
+            long d {a.dist[v] + a.g.value[i].weight};
+
+            if (a.reached[to] != gen || d < a.dist[to]) {
+
+                a.dist[to] = d;
+                a.prev[to] = v;
+                a.arc[to] = i;
+                a.reached[to] = gen;
+
+                a.pq.insert_or_decrease(to, d);
+            }
+        }
+    }
+
+    void start(Side &a, int v) {
+        a.pq.clear();
+        a.stopped = false;
+        a.dist[v] = 0;
+        a.prev[v] = v;
+        a.arc[v] = -1;
+        a.reached[v] = gen;
+        a.pq.insert(v, 0);
+    }
+
+    bool active(Side &a) {
+        if (!a.stopped && (a.pq.empty() || a.pq.key_of(a.pq.top()) >= mu))
+            a.stopped = true;
+        return !a.stopped;
+    }
+
+public:
+
+    CHQuery(const ContractionHierarchy &hierarchy): ch(hierarchy),
+        fwd(hierarchy.up, hierarchy.down), bwd(hierarchy.down, hierarchy.up) {};
+
+    /*
+     *  run, shortest path from source to target,
+     *      returns its length or INT_MAX if target is not reachable
+     */
+
+    int run(int source, int target) {
+
+        if (++gen == 0) {
+            std::fill(fwd.reached.begin(), fwd.reached.end(), 0);
+            std::fill(bwd.reached.begin(), bwd.reached.end(), 0);
+            gen = 1;
+        }
+
+        s = source;
+        t = target;
+        meet = -1;
+        mu = LONG_MAX;
+        n_settled = 0;
+
+        start(fwd, s);
+        start(bwd, t);
+
+        bool turn {false};
+
+        while (true) {
+
+            bool f {active(fwd)};
+            bool b {active(bwd)};
+
+            if (!f && !b) break;
+
+            turn = f && b ? !turn : f;
+
+            if (turn)
+                step(fwd, bwd);
+            else
+                step(bwd, fwd);
+        }
+
+        return distance();
+    }
+
+    int distance() const { return meet < 0 ? INT_MAX : (int) mu; }
+
+    /*
+     *  number of vertices settled by both searches in the last query
+     */
+
+    size_t settled_count() const { return n_settled; }
+
+    /*
+     *  path, vertices from source to target, empty if not reachable
+     */
+
+    std::vector<int> path() const {
+
+        std::vector<int> p;
+
+        if (meet < 0) return p;
+
+        // arcs s..meet of the upward search
+        std::vector<int> arcs;
+        for (int v = meet; v != s; v = fwd.prev[v])
+            arcs.push_back(fwd.arc[v]);
+
+        p.push_back(s);
+
+        int u {s};
+        for (auto i = arcs.rbegin(); i != arcs.rend(); ++i) {
+            int w {ch.up.target[*i]};
+            ch.unpack(u, w, ch.up.value[*i], p);
+            u = w;
+        }
+
+        // arcs meet..t, bwd.prev leads towards t
+        for (int v = meet; v != t; v = bwd.prev[v]) {
+            int i {bwd.arc[v]};
+            ch.unpack(v, bwd.prev[v], ch.down.value[i], p);
+        }
+
+        return p;
+    }
+
+    /*
+     *  previous chain of the path, previous[source] is source and
+     *      previous[v] is -1 for vertices not on the path
+     */
+
+    void previous(std::vector<int> &previous) const {
+
+        previous.assign(ch.n_vertices(), -1);
+
+        std::vector<int> p = path();
+
+        for (size_t i=0; i<p.size(); i++)
+            previous[p[i]] = i == 0 ? p[i] : p[i-1];
+    }
+};
+
+#endif /* CHQuery_hpp */
@@ -0,0 +1,69 @@
+//
+//  contraction-hierarchy.cpp
+//
+//  Builds a contraction hierarchy of a grid, saves it, loads it back
+//  and answers queries, compared with Dijkstra's algorithm,
+//  see contraction-hierarchy.hpp and ch-query.hpp
+//
+//  Created by mkuklik on 12/8/15.
+//  Copyright © 2015 mkuklik. All rights reserved.
+//
+
+#include <iostream>
+#include <vector>
+#include <chrono>
+
+#include "ch-query.hpp"
+#include "../Dijkstra Query/dijkstra-query.hpp"
+#include "../../Benchmarks/graph-generators.hpp"
+
+using namespace std;
+
+
+int main(int argc, const char * argv[]) {
+
+    string path = argc > 1 ? argv[1] : "grid.ch";
+
+    int side {100};
+
+    CSRGraph<int> g(side * side, grid(side, side, 1));
+
+    try {
+        auto t0 = chrono::steady_clock::now();
+        ContractionHierarchy built(g);
+        auto t1 = chrono::steady_clock::now();
+
+        cout << "vertices " << g.n_vertices() << ", edges " << g.n_edges() << ", shortcuts " <<
+                built.n_shortcuts() << ", built in " <<
+                chrono::duration<double>(t1 - t0).count() << "s" << endl;
+
+        built.save(path);
+
+        ContractionHierarchy ch(path);
+        CHQuery q(ch);
+        DijkstraQuery dq(g);
+
+        mt19937_64 rng(2);
+
+        for (int k=0; k<5; k++) {
+
+            int s = (int) uniform(rng, g.n_vertices());
+            int t = (int) uniform(rng, g.n_vertices());
+
+            int d = q.run(s, t);
+            dq.run(s, t);
+
+            vector<int> p = q.path();
+
+            cout << s << " -> " << t << ": " << d << " (dijkstra " << dq.distance(t) <<
+                    "), path of " << p.size() << " vertices, settled " << q.settled_count() <<
+                    " (dijkstra " << dq.settled_count() << ")" << endl;
+        }
+    }
+    catch (const char * e) {
+        cerr << e << endl;
+        return 1;
+    }
+
+    return 0;
+}
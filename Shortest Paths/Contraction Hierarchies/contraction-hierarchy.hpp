@@ -0,0 +1,427 @@
+//
+//  contraction-hierarchy.hpp
+//
+//  Contraction hierarchies (Geisberger, Sanders, Schultes, Delling 2008)
+//  preprocessing, upward/downward CSR layout and serialization
+//
+//  Created by mkuklik on 12/8/15.
+//  Copyright © 2015 mkuklik. All rights reserved.
+//
+
+/*
+ *  Vertices are contracted one by one in order of importance. When
+ *  vertex v is contracted it is removed from the graph, and for every
+ *  pair of remaining neighbours u->v->w a shortcut u->w with weight
+ *  w(u,v) + w(v,w) is added, unless a witness search finds a path from u
+ *  to w no longer than that which avoids v. Distances between the
+ *  remaining vertices stay the same. rank[v] is the step in which v was
+ *  contracted.
+ *
+ *  Order, vertices are kept in a heap keyed by
+ *
+ *      2 * (shortcuts added - edges removed) + contracted neighbours
+ *
+ *  (edge difference plus a term which spreads contraction evenly over
+ *  the graph). Keys are updated lazily: the top vertex's key is
+ *  computed again, if it's no longer the smallest it goes back to heap.
+ *
+ *  Witness searches are Dijkstra's searches from u limited by the
+ *  longest path through v and by a number of settled vertices. A search
+ *  which gives up only adds a shortcut that isn't needed, never loses
+ *  one.
+ *
+ *  When v is contracted its remaining arcs all go to vertices of higher
+ *  rank, they are the arcs of the hierarchy:
+ *
+ *      up      out-arcs v->w, rank[w] > rank[v]
+ *      down    in-arcs u->v, rank[u] > rank[v], stored at v with target u
+ *
+ *  Both are CSR graphs with Shortcut values, weight and the vertex the
+ *  shortcut skips (middle, -1 for an original edge). A shortcut u->w
+ *  with middle m is u->m, a down arc stored at m, followed by m->w, an
+ *  up arc of m; unpack() expands it recursively to original edges.
+ *
+ *  Query (ch-query.hpp) searches up from s and up the down arcs from t,
+ *  both searches only see vertices of higher rank and are tiny.
+ *
+ *  This works on road-like graphs (small separators, low degree). On
+ *  random or power-law graphs the last vertices form a dense core and
+ *  the number of shortcuts grows quadratically with its size.
+ *
+ *  save() writes the hierarchy in the CSR file format (csr-file.hpp),
+ *  the constructor from a path maps it back without copying.
+ */
+
+#ifndef ContractionHierarchy_hpp
+#define ContractionHierarchy_hpp
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <climits>
+#include <cstdint>
+#include <algorithm>
+
+#include "../../Binary Heap/binary-heap.hpp"
+#include "../../CSR Graph/csr-graph.hpp"
+#include "../../CSR Graph/csr-file.hpp"
+
+struct Shortcut {
+    int weight;
+    int middle;     // contracted vertex the arc skips, -1 for an original edge
+};
+
+
+class ContractionHierarchy {
+
+    /*
+     *  Contractor, graph which shrinks as vertices are contracted
+     */
+
+    class Contractor {
+
+        struct Arc {
+            int to;
+            int weight;
+            int middle;
+        };
+
+        int N;
+
+        std::vector<std::vector<Arc>> out;
+        std::vector<std::vector<Arc>> in;
+        std::vector<int> deleted;       // contracted neighbours
+
+        // witness search
+        IndexedBinaryHeap<long> pq;
+        std::vector<long> dist;
+        std::vector<uint32_t> reached;
+        uint32_t gen {0};
+        int limit;
+
+        struct Pair {
+            int from;
+            int to;
+            int weight;
+        };
+
+        std::vector<Pair> shortcuts;
+
+        /*
+         *  witness, distances from s in the graph without vertex skip, up
+         *      to bound or until limit vertices are settled
+         */
+
+        void witness(int s, int skip, long bound) {
+
+            pq.clear();
+
+            if (++gen == 0) {
+                std::fill(reached.begin(), reached.end(), 0);
+                gen = 1;
+            }
+
+            dist[s] = 0;
+            reached[s] = gen;
+            pq.insert(s, 0);
+
+            for (int settled = 0; !pq.empty() && settled < limit; settled++) {
+
+                int v {pq.pop()};
+
+                if (dist[v] > bound) break;
+
+                for (auto &a : out[v]) {
+
+                    if (a.to == skip) continue;
+
+                    long d {dist[v] + a.weight};
+
+                    if (reached[a.to] != gen || d < dist[a.to]) {
+                        dist[a.to] = d;
+                        reached[a.to] = gen;
+                        pq.insert_or_decrease(a.to, d);
+                    }
+                }
+            }
+        }
+
+        long witness_distance(int v) const { return reached[v] == gen ? dist[v] : LONG_MAX; }
+
+        /*
+         *  shortcuts needed when v is contracted, to shortcuts
+         */
+
+        void find_shortcuts(int v) {
+
+            shortcuts.clear();
+
+            long max_out {0};
+            for (auto &b : out[v])
+                max_out = std::max(max_out, (long) b.weight);
+
+            for (auto &a : in[v]) {
+
+                witness(a.to, v, a.weight + max_out);
+
+                for (auto &b : out[v]) {
+
+                    if (b.to == a.to) continue;
+
+                    long through {(long) a.weight + b.weight};
+
+                    if (witness_distance(b.to) > through)
+                        shortcuts.push_back(Pair {a.to, b.to, (int) through});
+                }
+            }
+        }
+
+        static void add_arc(std::vector<Arc> &arcs, int to, int weight, int middle) {
+
+            for (auto &a : arcs)
+                if (a.to == to) {
+                    if (weight < a.weight) {
+                        a.weight = weight;
+                        a.middle = middle;
+                    }
+                    return;
+                }
+
+            arcs.push_back(Arc {to, weight, middle});
+        }
+
+        static void remove_arc(std::vector<Arc> &arcs, int to) {
+
+            for (size_t i=0; i<arcs.size(); i++)
+                if (arcs[i].to == to) {
+                    arcs[i] = arcs.back();
+                    arcs.pop_back();
+                    return;
+                }
+        }
+
+    public:
+
+        Contractor(const CSRGraph<int> &g, int witness_limit): N(g.n_vertices()),
+            out(g.n_vertices()), in(g.n_vertices()), deleted(g.n_vertices(), 0),
+            pq(g.n_vertices()), dist(g.n_vertices()), reached(g.n_vertices(), 0),
+            limit(witness_limit) {
+
+            // parallel edges are merged to the shortest, loops dropped
+            for (int v=0; v<N; v++)
+                for (int i=g.offset[v]; i<g.offset[v+1]; i++)
+                    if (g.target[i] != v && g.value[i] < INT_MAX)
+                        add_arc(out[v], g.target[i], g.value[i], -1);
+
+            for (int v=0; v<N; v++)
+                for (auto &a : out[v])
+                    in[a.to].push_back(Arc {v, a.weight, -1});
+        }
+
+        int priority(int v) {
+
+            find_shortcuts(v);
+
+            return 2 * ((int) shortcuts.size() - (int) (in[v].size() + out[v].size())) + deleted[v];
+        }
+
+        /*
+         *  contract v, its arcs (all to uncontracted vertices) are
+         *      appended to up and down
+         */
+
+        void contract(int v, std::vector<CSRGraph<Shortcut>::Edge> &up,
+                      std::vector<CSRGraph<Shortcut>::Edge> &down) {
+
+            find_shortcuts(v);
+
+            for (auto &s : shortcuts) {
+                add_arc(out[s.from], s.to, s.weight, v);
+                add_arc(in[s.to], s.from, s.weight, v);
+            }
+
+            for (auto &a : out[v]) {
+                up.push_back(CSRGraph<Shortcut>::Edge(v, a.to, Shortcut {a.weight, a.middle}));
+                remove_arc(in[a.to], v);
+                ++deleted[a.to];
+            }
+
+            for (auto &a : in[v]) {
+                down.push_back(CSRGraph<Shortcut>::Edge(v, a.to, Shortcut {a.weight, a.middle}));
+                remove_arc(out[a.to], v);
+                ++deleted[a.to];
+            }
+
+            std::vector<Arc>().swap(out[v]);
+            std::vector<Arc>().swap(in[v]);
+        }
+    };
+
+    std::unique_ptr<MappedFile> file;   // when loaded from a file
+
+public:
+
+    int N {0};
+
+    CSRArray<int> rank;         // order of contraction
+    CSRGraph<Shortcut> up;      // arcs to higher rank
+    CSRGraph<Shortcut> down;    // arcs from higher rank, reversed
+
+    /*
+     *  build the hierarchy of g, witness searches settle at most
+     *      witness_limit vertices
+     */
+
+    ContractionHierarchy(const CSRGraph<int> &g, int witness_limit = 500):
+        N(g.n_vertices()), rank(g.n_vertices(), -1) {
+
+        Contractor c(g, witness_limit);
+
+        IndexedBinaryHeap<int> order(N);
+
+        for (int v=0; v<N; v++)
+            order.insert(v, c.priority(v));
+
+        std::vector<CSRGraph<Shortcut>::Edge> up_arcs, down_arcs;
+
+        int next {0};
+
+        while (!order.empty()) {
+
+            int v {order.pop()};
+            int p {c.priority(v)};
+
+            if (!order.empty() && p > order.key_of(order.top())) {
+                order.insert(v, p);     // key was out of date
+                continue;
+            }
+
+            c.contract(v, up_arcs, down_arcs);
+            rank[v] = next++;
+        }
+
+        up = CSRGraph<Shortcut>(N, up_arcs);
+        down = CSRGraph<Shortcut>(N, down_arcs);
+    }
+
+    /*
+     *  load hierarchy saved with save(), arrays are views of the mapped file;
+     *      validate checks all offsets and vertex ids, O(N + M)
+     */
+
+    ContractionHierarchy(const std::string &path, bool validate = false): file(new MappedFile(path)) {
+
+        CSRFileReader r(*file, CSR_CONTRACTION_HIERARCHY, sizeof(Shortcut));
+
+        size_t n = r.header.n_vertices;
+        size_t m_up = r.header.n_arcs;
+        size_t m_down = r.header.n_edges;
+
+        N = (int) n;
+        rank = r.array<CSRArray<int>>(n);
+
+        up.N = N;
+        up.offset = r.array<CSRArray<int>>(n + 1);
+        up.target = r.array<CSRArray<int>>(m_up);
+        up.value = r.array<CSRArray<Shortcut>>(m_up);
+
+        down.N = N;
+        down.offset = r.array<CSRArray<int>>(n + 1);
+        down.target = r.array<CSRArray<int>>(m_down);
+        down.value = r.array<CSRArray<Shortcut>>(m_down);
+
+        if (up.offset[0] != 0 || (size_t) up.offset[n] != m_up ||
+            down.offset[0] != 0 || (size_t) down.offset[n] != m_down)
+            throw "contraction hierarchy: corrupt file";
+
+        if (!validate) return;
+
+        if (!valid_offsets(up.offset, n, m_up) || !valid_offsets(down.offset, n, m_down) ||
+            !valid_ids(up.target, n) || !valid_ids(down.target, n) || !valid_ids(rank, n))
+            throw "contraction hierarchy: corrupt file";
+
+        // unpacking follows middle vertices
+        for (const CSRGraph<Shortcut> * g : {&up, &down})
+            for (const Shortcut &s : g->value)
+                if (s.middle < -1 || s.middle >= N) throw "contraction hierarchy: corrupt file";
+    }
+
+    /*
+     *  save, n_arcs of the header is the number of up arcs,
+     *      n_edges of down arcs
+     */
+
+    void save(const std::string &path) const {
+
+        CSRFileWriter w(path, csr_file_header<Shortcut>(CSR_CONTRACTION_HIERARCHY, N,
+                                                        up.target.size(), down.target.size()));
+        w.array(rank);
+        w.array(up.offset);
+        w.array(up.target);
+        w.array(up.value);
+        w.array(down.offset);
+        w.array(down.target);
+        w.array(down.value);
+        w.close();
+    }
+
+    int n_vertices() const { return N; }
+
+    /*
+     *  number of shortcuts, arcs which are not original edges
+     */
+
+    size_t n_shortcuts() const {
+
+        size_t n {0};
+
+        for (auto &a : up.value) n += a.middle >= 0;
+        for (auto &a : down.value) n += a.middle >= 0;
+
+        return n;
+    }
+
+    /*
+     *  unpack arc u->w of the hierarchy, appends the vertices of the
+     *      path of original edges after u (up to and including w)
+     */
+
+    void unpack(int u, int w, const Shortcut &arc, std::vector<int> &path) const {
+
+        struct Part { int u; int w; int middle; };
+
+        std::vector<Part> stack {Part {u, w, arc.middle}};
+
+        while (!stack.empty()) {
+
+            Part p = stack.back();
+            stack.pop_back();
+
+            if (p.middle < 0) {
+                path.push_back(p.w);
+                continue;
+            }
+
+            int m {p.middle};
+
+            // u->m is a down arc of m, m->w an up arc of m
+            const Shortcut * first {nullptr};
+            const Shortcut * second {nullptr};
+
+            for (int i=down.offset[m]; i<down.offset[m+1]; i++)
+                if (down.target[i] == p.u) first = &down.value[i];
+
+            for (int i=up.offset[m]; i<up.offset[m+1]; i++)
+                if (up.target[i] == p.w) second = &up.value[i];
+
+            if (first == nullptr || second == nullptr)
+                throw "contraction hierarchy: shortcut can't be unpacked";
+
+            // second half is done after the first one
+            stack.push_back(Part {m, p.w, second->middle});
+            stack.push_back(Part {p.u, m, first->middle});
+        }
+    }
+};
+
+#endif /* ContractionHierarchy_hpp */
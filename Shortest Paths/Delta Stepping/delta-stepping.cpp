@@ -0,0 +1,99 @@
+//
+//  delta-stepping.cpp
+//
+//  Parallel single-source shortest paths with delta-stepping,
+//  see delta-stepping.hpp
+//
+//  Created by mkuklik on 11/24/15.
+//  Copyright © 2015 mkuklik. All rights reserved.
+//
+
+#include <iostream>
+#include <vector>
+
+#include "delta-stepping.hpp"
+
+using namespace std;
+
+
+int main(int argc, const char * argv[]) {
+
+    CSRGraph<int>::Builder b(9);
+    b.add(0,1,4);
+    b.add(0,7,8);
+    b.add(1,2,8);
+    b.add(2,3,7);
+    b.add(2,5,4);
+    b.add(2,8,2);
+    b.add(7,8,7);
+    b.add(7,1,11);
+    b.add(7,6,1);
+    b.add(6,5,2);
+    b.add(6,8,6);
+    b.add(5,3,14);
+    b.add(5,4,10);
+    b.add(3,4,9);
+
+    CSRGraph<int> g = b.build();
+
+    g.print();
+
+    vector<int> dist;
+    vector<int> previous;
+
+    delta_stepping(g, 0, dist, previous, 3, 4);   // delta = 3, 4 threads
+
+    // print shortest paths
+
+    for (int i=0; i < g.n_vertices(); i++)
+        if (i != 0) {
+            cout << i << ", " << dist[i] << ": ";
+            int p = previous[i];
+            while (p != -1) {
+                cout << p << ", ";
+                p = previous[p];
+            }
+            cout << endl;
+        }
+
+    // zero weight edges both ways, previous must stay a tree
+
+    CSRGraph<int>::Builder z(3);
+    z.add(2,0,1);
+    z.add(2,1,1);
+    z.add(0,1,0);
+    z.add(1,0,0);
+
+    delta_stepping(z.build(), 2, dist, previous, 1, 1);
+
+    for (int i=0; i < 3; i++)
+        cout << i << ", " << dist[i] << ", " << previous[i] << endl;
+
+    return 0;
+}
+
+
+/* Output
+
+ 0: 1(4) 7(8)
+ 1: 2(8)
+ 2: 3(7) 5(4) 8(2)
+ 3: 4(9)
+ 4:
+ 5: 3(14) 4(10)
+ 6: 5(2) 8(6)
+ 7: 8(7) 1(11) 6(1)
+ 8:
+ 1, 4: 0,
+ 2, 12: 1, 0,
+ 3, 19: 2, 1, 0,
+ 4, 21: 5, 6, 7, 0,
+ 5, 11: 6, 7, 0,
+ 6, 9: 7, 0,
+ 7, 8: 0,
+ 8, 14: 2, 1, 0,
+ 0, 1, 2
+ 1, 1, 2
+ 2, 0, -1
+
+ */
@@ -0,0 +1,232 @@
+//
+//  delta-stepping.hpp
+//
+//  Created by mkuklik on 11/24/15.
+//  Copyright © 2015 mkuklik. All rights reserved.
+//
+
+/*
+
+ Delta-stepping, parallel single-source shortest paths
+ (Meyer, Sanders 2003)
+
+ Dijkstra settles vertices one by one in order of distance, which is
+ inherently sequential. Delta-stepping groups tentative distances into
+ buckets of width delta, bucket i holds vertices with
+
+     i*delta <= dist(v) < (i+1)*delta
+
+ and relaxes all the vertices in the lowest non-empty bucket at once,
+ in parallel. Relaxation can put vertices back into the current bucket,
+ which is then processed again, until it stays empty.
+
+ delta = 1 with integer weights is Dijkstra (one distance per bucket),
+ delta = inf is Bellman-Ford. Too small means many nearly empty buckets,
+ too large means vertices are relaxed many times; the default is the
+ largest weight over the average degree (Meyer, Sanders, Theta(1/d)
+ for random weights in [0, 1]). Weights must not be negative.
+
+ Implementation
+
+ - dist and previous of a vertex are packed into one 64-bit word,
+   (dist << 32 | previous), and updated with compare-and-swap. Smaller
+   word wins, so a relaxation never leaves dist from one edge and
+   previous from another, and among equally short paths the one through
+   the vertex with the lowest id wins, results don't depend on thread
+   timing. Except over zero weight edges: there previous only changes
+   when dist goes down, otherwise u -> v -> u with weights 0 would make
+   them each other's previous (and s would get one). Which of equally
+   short zero weight paths wins depends on timing.
+ - every thread has its own buckets, vertices it improved go there,
+   no locking when relaxing. Entries are not removed when a vertex moves
+   to a lower bucket; stale ones are skipped when the bucket is processed.
+ - relaxing bucket i only reaches buckets i .. i + max weight / delta + 1,
+   so buckets are a cyclic array of that many, bucket i is in i % nb and
+   memory doesn't grow with distances. delta is raised if the array
+   would have more than 2^16 buckets.
+ - a round: threads take chunks of the shared frontier (current bucket)
+   and relax it, then agree on the next non-empty bucket, then gather it
+   from their local buckets into the frontier. Rounds are separated with
+   barriers.
+
+*/
+
+#ifndef DeltaStepping_hpp
+#define DeltaStepping_hpp
+
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <cstdint>
+#include <climits>
+
+#include "../../CSR Graph/csr-graph.hpp"
+#include "../../Parallel/barrier.hpp"
+
+/*
+ *  delta_stepping, shortest paths from s; dist[v] is INT_MAX and
+ *      previous[v] is -1 when v is not reachable, previous[s] is -1
+ *
+ *      delta       bucket width, 0 picks max weight / average degree
+ *      n_threads   number of threads, 0 picks one per core
+ */
+
+inline void delta_stepping(const CSRGraph<int> &g, int s,
+                           std::vector<int> &dist, std::vector<int> &previous,
+                           int delta = 0, int n_threads = 0) {
+
+    if (delta < 0) throw "delta_stepping: delta must not be negative";
+
+    if (n_threads <= 0)
+        n_threads = std::max(1u, std::thread::hardware_concurrency());
+
+    const int n_v = g.n_vertices();
+    const size_t NONE = SIZE_MAX;       // no bucket
+    const int CHUNK = 64;               // vertices taken from the frontier at once
+    const int MAX_BUCKETS = 1 << 16;
+
+    int max_w {0};
+    for (auto w : g.value) {
+        if (w < 0) throw "delta_stepping: negative edge weight";
+        max_w = std::max(max_w, w);
+    }
+
+    if (delta == 0) {
+        int degree = n_v > 0 ? std::max(1, g.n_edges() / n_v) : 1;
+        delta = std::max(1, max_w / degree);
+    }
+
+    if (max_w / delta + 2 > MAX_BUCKETS)
+        delta = max_w / (MAX_BUCKETS - 2) + 1;
+
+    const size_t nb = (size_t) (max_w / delta + 2);     // cyclic buckets
+
+    auto pack = [] (int d, int p) -> uint64_t {
+        return ((uint64_t) (uint32_t) d << 32) | (uint32_t) p;
+    };
+
+    std::vector<std::atomic<uint64_t>> state(n_v);
+    for (int i=0; i < n_v; i++)
+        state[i].store(pack(INT_MAX, -1), std::memory_order_relaxed);
+
+    state[s].store(pack(0, -1), std::memory_order_relaxed);
+
+    std::vector<int> frontier {s};      // vertices of the current bucket
+    std::atomic<size_t> cursor {0};     // next unprocessed vertex in frontier
+    std::atomic<size_t> next_bucket {NONE};
+    std::mutex gather;
+
+    // [thread][bucket % nb]
+    std::vector<std::vector<std::vector<int>>> local(n_threads, std::vector<std::vector<int>>(nb));
+
+    Barrier barrier(n_threads);
+
+    auto worker = [&] (int t) {
+
+        std::vector<std::vector<int>> &buckets = local[t];
+        size_t cur {0};         // current bucket, not wrapped
+
+        while (true) {
+
+            // relax edges of vertices in the current bucket
+
+            size_t k;
+            while ((k = cursor.fetch_add(CHUNK)) < frontier.size()) {
+
+                size_t last = std::min(k + CHUNK, frontier.size());
+
+                for (; k < last; k++) {
+
+                    int u = frontier[k];
+                    int du = (int) (state[u].load(std::memory_order_relaxed) >> 32);
+
+                    if ((size_t) du / delta != cur) continue;   // stale entry
+
+                    for (int i = g.offset[u]; i < g.offset[u+1]; i++) {
+
+                        int to = g.target[i];
+                        long long nd = (long long) du + g.value[i];
+                        if (nd >= INT_MAX) continue;
+
+                        uint64_t w = pack((int) nd, u);
+                        uint64_t old = state[to].load(std::memory_order_relaxed);
+
+                        // equal dist through a zero weight edge is no improvement
+                        bool improved {false};
+                        while (w < old && ((old >> 32) > (uint64_t) nd || g.value[i] > 0)) {
+                            if (state[to].compare_exchange_weak(old, w, std::memory_order_relaxed)) {
+                                improved = true;
+                                break;
+                            }
+                        }
+
+                        if (improved && (old >> 32) != (uint64_t) nd) {
+                            // vertex moves to a new bucket, (only previous
+                            // changes if distance is the same)
+                            buckets[(size_t) nd / delta % nb].push_back(to);
+                        }
+                    }
+                }
+            }
+
+            barrier.wait();
+
+            // agree on the next non-empty bucket
+
+            if (t == 0) {
+                frontier.clear();
+                cursor.store(0);
+            }
+
+            size_t mine = cur;
+            while (mine < cur + nb && buckets[mine % nb].empty()) ++mine;
+
+            if (mine < cur + nb) {
+                size_t next = next_bucket.load();
+                while (mine < next && !next_bucket.compare_exchange_weak(next, mine));
+            }
+
+            barrier.wait();
+
+            cur = next_bucket.load();
+            if (cur == NONE) break;
+
+            // gather the bucket from all the threads into the frontier
+
+            std::vector<int> &bucket = buckets[cur % nb];
+
+            if (!bucket.empty()) {
+                std::lock_guard<std::mutex> lock(gather);
+                frontier.insert(frontier.end(), bucket.begin(), bucket.end());
+                bucket.clear();
+            }
+
+            barrier.wait();
+
+            if (t == 0)
+                next_bucket.store(NONE);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int t=1; t < n_threads; t++)
+        threads.push_back(std::thread(worker, t));
+
+    worker(0);
+
+    for (auto &th : threads)
+        th.join();
+
+    dist.assign(n_v, INT_MAX);
+    previous.assign(n_v, -1);
+
+    for (int i=0; i < n_v; i++) {
+        uint64_t w = state[i].load(std::memory_order_relaxed);
+        dist[i] = (int) (w >> 32);
+        previous[i] = (int) (uint32_t) w;
+    }
+}
+
+#endif /* DeltaStepping_hpp */
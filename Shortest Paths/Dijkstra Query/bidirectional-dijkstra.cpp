@@ -0,0 +1,67 @@
+//
+//  bidirectional-dijkstra.cpp
+//
+//  Point to point queries with bidirectional Dijkstra's algorithm
+//  compared with DijkstraQuery, see bidirectional-dijkstra.hpp
+//
+//  Created by mkuklik on 12/6/15.
+//  Copyright © 2015 mkuklik. All rights reserved.
+//
+
+#include <iostream>
+#include <vector>
+
+#include "bidirectional-dijkstra.hpp"
+#include "dijkstra-query.hpp"
+
+using namespace std;
+
+
+int main(int argc, const char * argv[]) {
+
+    CSRGraph<int>::Builder b(9);
+    b.add(0,1,4);
+    b.add(0,7,8);
+    b.add(1,2,8);
+    b.add(2,3,7);
+    b.add(2,5,4);
+    b.add(2,8,2);
+    b.add(7,8,7);
+    b.add(7,1,11);
+    b.add(7,6,1);
+    b.add(6,5,2);
+    b.add(6,8,6);
+    b.add(5,3,14);
+    b.add(5,4,10);
+    b.add(3,4,9);
+
+    CSRGraph<int> g = b.build();
+
+    DijkstraQuery q(g);
+    BidirectionalDijkstraQuery bq(g);
+
+    int queries[][2] = {{0, 8}, {0, 4}, {7, 3}, {2, 4}, {4, 0}, {3, 3}};
+
+    for (auto &st : queries) {
+
+        int d = bq.run(st[0], st[1]);
+
+        cout << st[0] << " -> " << st[1] << ": ";
+
+        if (d == INT_MAX) {
+            cout << "not reachable" << endl;
+            continue;
+        }
+
+        cout << d << ", path";
+        for (auto v : bq.path())
+            cout << " " << v;
+
+        q.run(st[0], st[1]);
+
+        cout << ", settled " << bq.settled_count() << " (one direction " <<
+                q.settled_count() << ")" << endl;
+    }
+
+    return 0;
+}
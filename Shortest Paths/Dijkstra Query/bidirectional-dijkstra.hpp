@@ -0,0 +1,230 @@
+//
+//  bidirectional-dijkstra.hpp
+//
+//  Bidirectional Dijkstra's algorithm for point to point queries
+//
+//  Created by mkuklik on 12/6/15.
+//  Copyright © 2015 mkuklik. All rights reserved.
+//
+
+/*
+ *  Two searches run at the same time, forward from s on the graph and
+ *  backward from t on the reverse graph (CSRGraph::reverse, the same
+ *  edges with ends swapped). Each step settles one vertex from the side
+ *  with the smaller heap.
+ *
+ *  mu is the length of the best s-t path seen so far: whenever an edge
+ *  (v, w) is scanned and w was reached by the other side, the path
+ *  s..v w..t is a candidate. Search stops when
+ *
+ *      top of forward heap + top of backward heap >= mu
+ *
+ *  as no path through an unsettled vertex can be shorter than that,
+ *  (Pohl 1971). The meeting vertex is not necessarily settled by both
+ *  sides, which is why mu is kept instead of stopping at the first
+ *  vertex settled twice.
+ *
+ *  Each search settles vertices up to about half of the s-t distance,
+ *  on road-like graphs that's roughly half of what a one-directional
+ *  search settles.
+ *
+ *  Buffers are reused between queries with generation stamps, as in
+ *  DijkstraQuery.
+ */
+
+#ifndef BidirectionalDijkstra_hpp
+#define BidirectionalDijkstra_hpp
+
+#include <vector>
+#include <climits>
+#include <cstdint>
+#include <algorithm>
+
+#include "../../Binary Heap/binary-heap.hpp"
+#include "../../CSR Graph/csr-graph.hpp"
+
+class BidirectionalDijkstraQuery {
+
+    /*
+     *  Side, state of search in one direction
+     */
+
+    struct Side {
+
+        const CSRGraph<int> &g;
+
+        IndexedBinaryHeap<int> pq;
+
+        std::vector<int> dist;
+        std::vector<int> prev;
+        std::vector<uint32_t> reached;
+        std::vector<uint32_t> done;
+
+        Side(const CSRGraph<int> &graph): g(graph), pq(graph.n_vertices()),
+            dist(graph.n_vertices()), prev(graph.n_vertices()),
+            reached(graph.n_vertices(), 0), done(graph.n_vertices(), 0) {};
+
+        void wipe() {
+            std::fill(reached.begin(), reached.end(), 0);
+            std::fill(done.begin(), done.end(), 0);
+        }
+
+        long top_key() const { return pq.key_of(pq.top()); }
+    };
+
+    CSRGraph<int> rev;      // reverse graph, unless given by the caller
+
+    Side fwd;
+    Side bwd;
+
+    uint32_t gen {0};
+    int s {-1};
+    int t {-1};
+    int meet {-1};          // vertex on the shortest path where searches met
+    long mu {LONG_MAX};     // length of the best path found
+    size_t n_settled {0};
+
+    void next_generation() {
+
+        fwd.pq.clear();
+        bwd.pq.clear();
+        n_settled = 0;
+
+        if (++gen == 0) {
+            fwd.wipe();
+            bwd.wipe();
+            gen = 1;
+        }
+    }
+
+    /*
+     *  settle the top vertex of side a, other is the opposite search
+     */
+
+    void step(Side &a, const Side &other) {
+
+        int v {a.pq.pop()};
+
+        a.done[v] = gen;
+        ++n_settled;
+
+        for (int i = a.g.offset[v]; i < a.g.offset[v+1]; i++) {
+
+            int to {a.g.target[i]};
+            int d {a.dist[v] + a.g.value[i]};
+
+            if (a.done[to] != gen && (a.reached[to] != gen || d < a.dist[to])) {
+
+                a.dist[to] = d;
+                a.prev[to] = v;
+                a.reached[to] = gen;
+
+                a.pq.insert_or_decrease(to, d);
+            }
+
+            if (other.reached[to] == gen && (long) d + other.dist[to] < mu) {
+                mu = (long) d + other.dist[to];
+                meet = to;
+            }
+        }
+    }
+
+public:
+
+    /*
+     *  reverse graph is built from g
+     */
+
+    BidirectionalDijkstraQuery(const CSRGraph<int> &g): rev(g.reverse()), fwd(g), bwd(rev) {};
+
+    /*
+     *  reverse graph is given, e.g. shared by many queries
+     */
+
+    BidirectionalDijkstraQuery(const CSRGraph<int> &g, const CSRGraph<int> &reverse):
+        fwd(g), bwd(reverse) {};
+
+    // bwd may point at rev, a copy would point into the original
+    BidirectionalDijkstraQuery(const BidirectionalDijkstraQuery &) = delete;
+    BidirectionalDijkstraQuery & operator=(const BidirectionalDijkstraQuery &) = delete;
+
+    /*
+     *  run, shortest path from source to target,
+     *      returns its length or INT_MAX if target is not reachable
+     */
+
+    int run(int source, int target) {
+
+        next_generation();
+
+        s = source;
+        t = target;
+        meet = -1;
+        mu = LONG_MAX;
+
+        fwd.dist[s] = 0;
+        fwd.prev[s] = s;
+        fwd.reached[s] = gen;
+        fwd.pq.insert(s, 0);
+
+        bwd.dist[t] = 0;
+        bwd.prev[t] = t;
+        bwd.reached[t] = gen;
+        bwd.pq.insert(t, 0);
+
+        if (s == t) {
+            mu = 0;
+            meet = s;
+        }
+
+        while (!fwd.pq.empty() && !bwd.pq.empty()) {
+
+            if (fwd.top_key() + bwd.top_key() >= mu) break;
+
+            if (fwd.pq.size() <= bwd.pq.size())
+                step(fwd, bwd);
+            else
+                step(bwd, fwd);
+        }
+
+        return distance();
+    }
+
+    /*
+     *  distance from source to target, INT_MAX if not reachable
+     */
+
+    int distance() const { return meet < 0 ? INT_MAX : (int) mu; }
+
+    /*
+     *  number of vertices settled by both searches in the last query
+     */
+
+    size_t settled_count() const { return n_settled; }
+
+    /*
+     *  path, vertices from source to target, empty if not reachable
+     */
+
+    std::vector<int> path() const {
+
+        std::vector<int> p;
+
+        if (meet < 0) return p;
+
+        for (int v = meet; v != s; v = fwd.prev[v])
+            p.push_back(v);
+
+        p.push_back(s);
+        std::reverse(p.begin(), p.end());
+
+        for (int v = meet; v != t; ) {
+            v = bwd.prev[v];
+            p.push_back(v);
+        }
+
+        return p;
+    }
+};
+
+#endif /* BidirectionalDijkstra_hpp */
@@ -0,0 +1,164 @@
+//
+//  dijkstra-query.hpp
+//
+//  Reusable Dijkstra's algorithm for many queries on one graph
+//
+//  Created by mkuklik on 12/5/15.
+//  Copyright © 2015 mkuklik. All rights reserved.
+//
+
+/*
+ *  dijkstras_binary_heap allocates dist, previous, visited and a heap
+ *  on every call, O(V) work before the search even starts. For point
+ *  to point queries, which usually settle a small part of the graph,
+ *  that's most of the cost.
+ *
+ *  DijkstraQuery keeps these buffers between queries and resets them
+ *  lazily: every query gets a new generation number and a vertex's
+ *  dist and previous are valid only if its stamp equals the current
+ *  generation; anything older reads as unreached. A reset is
+ *  incrementing gen plus clearing what is left in the heap. Arrays are
+ *  wiped for real only when gen wraps around, once in 2^32 queries.
+ *
+ *  run(s, t) stops as soon as t is settled. Only settled vertices have
+ *  final distances then, others have an upper bound (or none).
+ *
+ *  One DijkstraQuery per thread, the graph can be shared.
+ */
+
+#ifndef DijkstraQuery_hpp
+#define DijkstraQuery_hpp
+
+#include <vector>
+#include <climits>
+#include <cstdint>
+#include <algorithm>
+
+#include "../../Binary Heap/binary-heap.hpp"
+#include "../../CSR Graph/csr-graph.hpp"
+
+class DijkstraQuery {
+
+    const CSRGraph<int> &g;
+
+    IndexedBinaryHeap<int> pq;  // vertices keyed by distance
+
+    std::vector<int> dist;
+    std::vector<int> prev;
+    std::vector<uint32_t> reached;  // generation in which dist/prev were set
+    std::vector<uint32_t> done;     // generation in which vertex was settled
+
+    uint32_t gen {0};
+    int s {-1};
+    size_t n_settled {0};
+
+    void next_generation() {
+
+        pq.clear();     // only what's left of an early stopped query
+        n_settled = 0;
+
+        if (++gen == 0) {   // wrapped around, old stamps could match
+            std::fill(reached.begin(), reached.end(), 0);
+            std::fill(done.begin(), done.end(), 0);
+            gen = 1;
+        }
+    }
+
+public:
+
+    DijkstraQuery(const CSRGraph<int> &graph): g(graph), pq(graph.n_vertices()),
+        dist(graph.n_vertices()), prev(graph.n_vertices()),
+        reached(graph.n_vertices(), 0), done(graph.n_vertices(), 0) {};
+
+    /*
+     *  run, shortest paths from source; if target is given stops when
+     *      it's settled. Returns distance to target (INT_MAX if not
+     *      reachable), or 0 without a target.
+     */
+
+    int run(int source, int target = -1) {
+
+        next_generation();
+
+        s = source;
+
+        dist[s] = 0;
+        prev[s] = s;
+        reached[s] = gen;
+
+        pq.insert(s, 0);
+
+        while (!pq.empty()) {
+
+            int v {pq.pop()};
+
+            done[v] = gen;
+            ++n_settled;
+
+            if (v == target) break;
+
+            for (int i = g.offset[v]; i < g.offset[v+1]; i++) {
+
+                int to {g.target[i]};
+                int d {dist[v] + g.value[i]};
+
+                if (done[to] == gen) continue;
+
+                if (reached[to] != gen || d < dist[to]) {
+
+                    dist[to] = d;
+                    prev[to] = v;
+                    reached[to] = gen;
+
+                    pq.insert_or_decrease(to, d);
+                }
+            }
+        }
+
+        return target < 0 ? 0 : distance(target);
+    }
+
+    int source() const { return s; }
+
+    /*
+     *  distance from the source, INT_MAX if v wasn't reached
+     */
+
+    int distance(int v) const { return reached[v] == gen ? dist[v] : INT_MAX; }
+
+    /*
+     *  previous vertex on the path, source for the source itself
+     *      and -1 if v wasn't reached
+     */
+
+    int previous(int v) const { return reached[v] == gen ? prev[v] : -1; }
+
+    bool settled(int v) const { return done[v] == gen; }
+
+    /*
+     *  number of vertices settled by the last query
+     */
+
+    size_t settled_count() const { return n_settled; }
+
+    /*
+     *  path, vertices from the source to v, empty if v wasn't reached
+     */
+
+    std::vector<int> path(int v) const {
+
+        std::vector<int> p;
+
+        if (reached[v] != gen) return p;
+
+        for (; v != s; v = prev[v])
+            p.push_back(v);
+
+        p.push_back(s);
+
+        std::reverse(p.begin(), p.end());
+        return p;
+    }
+};
+
+#endif /* DijkstraQuery_hpp */
@@ -56,7 +56,9 @@
 #include <cmath>
 #include <climits>
 
-#include "fibonacci-heap.hpp"
+#include "dijkstras-fibonacci-heap.hpp"
+#include "../../Radix Heap/radix-heap.hpp"
+#include "../../Pairing Heap/pairing-heap.hpp"
 
 using namespace std;
 
@@ -113,6 +115,21 @@ struct Graph {
         }
     }
     
+    /*
+     *  csr, copy of the graph in compressed sparse row form
+     */
+    
+    CSRGraph<int> csr() const {
+        
+        CSRGraph<int>::Builder b(n_v, edges.size());
+        
+        for (int i=0; i < n_v; i++)
+            for (Edge * e = vertex[i]; e != nullptr; e = e->next)
+                b.add(i, e->to, e->value);
+        
+        return b.build();
+    }
+    
     /*
      *  print
      */
@@ -134,61 +151,20 @@ struct Graph {
 
 
 /*
- *  Dijkstra's algorithms using Fibonacci Heap
+ *  Dijkstra's algorithms using Fibonacci Heap, see dijkstras-fibonacci-heap.hpp;
+ *  the heap can be changed at compile time, e.g. dijkstras<RadixHeap<int>>(g, s)
+ *  or dijkstras<PairingHeap<int>>(g, s)
  */
 
-
-void dijkstras(const Graph &g, int s) {
+template<typename Heap = FibonacciHeap<int>>
+void dijkstras(const CSRGraph<int> &g, int s) {
     
     int n_v = g.n_vertices();
     
-    FibonacciHeap<int> heap;    // heap node stores the vertex id
-    
-    typedef FibonacciHeap<int>::Node Node;
-    
-    vector<Node *> lookup(n_v, nullptr);
-    vector<bool> visited(n_v);
-    vector<int> dist(n_v);
-    vector<int> previous(n_v);
-    
-    for (int i=0; i < n_v; i++) {
-        dist[i] = (i == s) ? 0 : INT_MAX;
-        lookup[i] = heap.insert(dist[i], i);   // lookup Node address, used to decrease a key
-        previous[i] = -1;
-    }
-    
-    
-//    make_heap(vd.begin(), vd.end());   // version 1 & 2
-    // or make_heap(vd.begin(), vd.end(), Vcomp); // version 3
+    vector<int> dist;
+    vector<int> previous;
     
-    while (heap.size() > 0) {
-        
-        int v = heap.get_min_node()->value;  // vertex id with minimum key, i.e. distance
-        
-        heap.remove_min();
-        
-        visited[v] = true;  // v is removed from heap, keeps track of
-                            // vertices on one side of the cut
-        
-        // Iterate over edges originating from v
-        // and update distance to end vertices
-        
-        auto e = g.vertex[v];   // first edge
-        while (e != nullptr) {
-            
-            int to {e->to}; // end vertex of the edge
-            
-            if (!visited[to] && dist[to] > dist[v] + e->value ) {
-                
-                dist[to] = dist[v] + e->value;
-                previous[to] = v;
-                
-                // update heap
-                heap.decrease_key(lookup[to], dist[to]);
-            }
-            e = e->next;
-        }
-    }
+    dijkstras_heap<Heap>(g, s, dist, previous);
     
     
     // print shortest paths
@@ -205,6 +181,15 @@ void dijkstras(const Graph &g, int s) {
         }
 }
 
+/*
+ *  dijkstras on the linked-list Graph runs on its CSR copy
+ */
+
+template<typename Heap = FibonacciHeap<int>>
+void dijkstras(const Graph &g, int s) {
+    dijkstras<Heap>(g.csr(), s);
+}
+
 
 int main(int argc, const char * argv[]) {
     
@@ -0,0 +1,92 @@
+//
+//  dijkstras-fibonacci-heap.hpp
+//
+//  Created by mkuklik on 11/11/15.
+//  Copyright © 2015 mkuklik. All rights reserved.
+//
+
+#ifndef DijkstrasFibonacciHeap_hpp
+#define DijkstrasFibonacciHeap_hpp
+
+#include <vector>
+#include <climits>
+
+#include "fibonacci-heap.hpp"
+#include "../../CSR Graph/csr-graph.hpp"
+
+/*
+ *  Dijkstra's algorithms using Fibonacci Heap
+ *
+ *  dist[v] is INT_MAX if v is not reachable, previous[v] is -1 for s
+ *  and vertices that are not reachable
+ *
+ *  The heap is a template parameter, any heap with integer keys and
+ *  the FibonacciHeap interface works, e.g. RadixHeap<int>
+ *  (radix-heap.hpp), which is faster as distances are monotone, or
+ *  PairingHeap<int> (pairing-heap.hpp), with smaller nodes and cheaper
+ *  decrease_key.
+ */
+
+template<typename Heap = FibonacciHeap<int>>
+inline void dijkstras_heap(const CSRGraph<int> &g, int s,
+                           std::vector<int> &dist, std::vector<int> &previous) {
+    
+    int n_v = g.n_vertices();
+    
+    Heap heap;                  // heap node stores the vertex id
+    heap.reserve(n_v);          // all nodes in one block
+    
+    typedef typename Heap::Node Node;
+    
+    std::vector<Node *> lookup(n_v, nullptr);
+    std::vector<bool> visited(n_v);
+    
+    dist.resize(n_v);
+    previous.resize(n_v);
+    
+    for (int i=0; i < n_v; i++) {
+        dist[i] = (i == s) ? 0 : INT_MAX;
+        lookup[i] = heap.insert(dist[i], i);   // lookup Node address, used to decrease a key
+        previous[i] = -1;
+    }
+    
+    
+//    make_heap(vd.begin(), vd.end());   // version 1 & 2
+    // or make_heap(vd.begin(), vd.end(), Vcomp); // version 3
+    
+    while (heap.size() > 0) {
+        
+        int v = heap.get_min_node()->value;  // vertex id with minimum key, i.e. distance
+        
+        heap.remove_min();
+        
+        if (dist[v] == INT_MAX) break;  // the rest is not reachable from s
+        
+        visited[v] = true;  // v is removed from heap, keeps track of
+                            // vertices on one side of the cut
+        
+        // Iterate over edges originating from v
+        // and update distance to end vertices
+        
+        for (int i = g.offset[v]; i < g.offset[v+1]; i++) {
+            
+            int to {g.target[i]}; // end vertex of the edge
+            
+            if (!visited[to] && dist[to] > dist[v] + g.value[i] ) {
+                
+                dist[to] = dist[v] + g.value[i];
+                previous[to] = v;
+                
+                // update heap
+                heap.decrease_key(lookup[to], dist[to]);
+            }
+        }
+    }
+}
+
+inline void dijkstras_fibonacci_heap(const CSRGraph<int> &g, int s,
+                                     std::vector<int> &dist, std::vector<int> &previous) {
+    dijkstras_heap<FibonacciHeap<int>>(g, s, dist, previous);
+}
+
+#endif /* DijkstrasFibonacciHeap_hpp */
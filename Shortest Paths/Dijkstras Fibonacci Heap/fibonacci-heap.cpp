@@ -6,6 +6,8 @@
 //  Copyright © 2015 mkuklik. All rights reserved.
 //
 
+#include <climits>
+
 #include "fibonacci-heap.hpp"
 
 /*
@@ -13,8 +15,8 @@
  *        in the linked list
  */
 
-template<typename T>
-void FibonacciHeap<T>::list_insert(Node * x, Node * l, Node * r) {
+template<typename T, template<typename> class Allocator>
+void FibonacciHeap<T, Allocator>::list_insert(Node * x, Node * l, Node * r) {
     // insert Node x between node l and r in double-linked list
     
     x->left = l;
@@ -28,10 +30,10 @@ void FibonacciHeap<T>::list_insert(Node * x, Node * l, Node * r) {
  *  insert new node with key k and value v
  */
 
-template<typename T>
-typename FibonacciHeap<T>::Node * FibonacciHeap<T>::insert(int k, T v) {
+template<typename T, template<typename> class Allocator>
+typename FibonacciHeap<T, Allocator>::Node * FibonacciHeap<T, Allocator>::insert(int k, T v) {
     
-    Node * tmp = new Node(k, v);
+    Node * tmp = alloc.create(k, v);
     
     if (root == nullptr) {
         
@@ -49,8 +51,8 @@ typename FibonacciHeap<T>::Node * FibonacciHeap<T>::insert(int k, T v) {
     return tmp;
 }
 
-template<typename T>
-typename FibonacciHeap<T>::Node * FibonacciHeap<T>::get_min_node() {
+template<typename T, template<typename> class Allocator>
+typename FibonacciHeap<T, Allocator>::Node * FibonacciHeap<T, Allocator>::get_min_node() {
     
     if (root == nullptr)
         throw "heap is empty";
@@ -58,8 +60,8 @@ typename FibonacciHeap<T>::Node * FibonacciHeap<T>::get_min_node() {
         return root;
 }
 
-template<typename T>
-int FibonacciHeap<T>::get_min_key() {
+template<typename T, template<typename> class Allocator>
+int FibonacciHeap<T, Allocator>::get_min_key() {
     
     if (root == nullptr)
         throw "heap is empty";
@@ -67,8 +69,8 @@ int FibonacciHeap<T>::get_min_key() {
         return root->key;
 }
 
-template<typename T>
-void FibonacciHeap<T>::remove_min() {
+template<typename T, template<typename> class Allocator>
+void FibonacciHeap<T, Allocator>::remove_min() {
     
     if (root == nullptr)
         throw "heap is empty";
@@ -103,15 +105,15 @@ void FibonacciHeap<T>::remove_min() {
         consolidate();
     }
     --N;
-    delete z;
+    alloc.destroy(z);
 }
 
 /*
  *   looks two trees with the same degree. y
  */
 
-template<typename T>
-typename FibonacciHeap<T>::Node * FibonacciHeap<T>::heap_link(Node * x, Node * y) {
+template<typename T, template<typename> class Allocator>
+typename FibonacciHeap<T, Allocator>::Node * FibonacciHeap<T, Allocator>::heap_link(Node * x, Node * y) {
     
     if (root == nullptr)
         throw "heap is empty";
@@ -156,23 +158,20 @@ typename FibonacciHeap<T>::Node * FibonacciHeap<T>::heap_link(Node * x, Node * y
  *  in the root linked-list
  */
 
-template<typename T>
-void FibonacciHeap<T>::consolidate() {
+template<typename T, template<typename> class Allocator>
+void FibonacciHeap<T, Allocator>::consolidate() {
     //
     
     if (root == nullptr)
         throw "consolidate: Heap is empty";
     
-    // size of the array required for consolidation
-    const int D { (int) floor(log( (double) N)/log((1.0 + sqrt(5))/2.0)) };
-    
-    std::vector<Node * > A(D, nullptr);
+    // A is indexed by degree, all entries are nullptr between calls
+    Node ** A {by_degree};
+    int max_d {0};
     
     // pointers to all the nodes in the root list are stored in vector root_list
     // Note that relinking nodes disrupts iteration over nodes via linked linst pointers
-    std::vector<Node * > root_list;
-    
-    root_list.reserve(N); // pick better size
+    root_list.clear();  // keeps its capacity, no allocation once it has grown
     
     // populate root_list
     //      it is a bad idea to iterate over the root linked-list
@@ -193,7 +192,7 @@ void FibonacciHeap<T>::consolidate() {
         Node * x {w};
         int d = x->degree;
         
-        assert(d < D); // if D is too small A overflows
+        assert(d < MAX_DEGREE);
         
         // if tree with the same degree is in A, link them
         while (A[d] != nullptr) {
@@ -205,18 +204,20 @@ void FibonacciHeap<T>::consolidate() {
             A[d] = nullptr;
             ++d;
             
-            //assert(A[d]==nullptr);  // what if x replaces existing pointer in A[d++] ?
+            assert(d < MAX_DEGREE);
         }
+        
         // if A[d] is empty x goes to A[d]
         // if x is linked with tree in A[d], x has higher degree
         A[d] = x;
         
+        if (d > max_d) max_d = d;
     }
     
     // reset root;
     root = nullptr;
     
-    for (int i = 0; i < D; i++) {
+    for (int i = 0; i <= max_d; i++) {
         
         if (A[i] != nullptr) {
             
@@ -237,12 +238,14 @@ void FibonacciHeap<T>::consolidate() {
                 if (A[i]->key < root->key)
                     root = A[i];
             }
+            
+            A[i] = nullptr;
         }
     }
 }
 
-template<typename T>
-void FibonacciHeap<T>::decrease_key(Node * x, int k) {
+template<typename T, template<typename> class Allocator>
+void FibonacciHeap<T, Allocator>::decrease_key(Node * x, int k) {
     
     if (k > x->key)
         throw "new key is greater than current minimum key";
@@ -265,8 +268,8 @@ void FibonacciHeap<T>::decrease_key(Node * x, int k) {
  *  cut removes Node x from the, y, parent's children list
  */
 
-template<typename T>
-void FibonacciHeap<T>::cut(Node * x, Node * y) {
+template<typename T, template<typename> class Allocator>
+void FibonacciHeap<T, Allocator>::cut(Node * x, Node * y) {
     
     if (x->parent != y)
         throw "y is not a parent of x";
@@ -308,8 +311,8 @@ void FibonacciHeap<T>::cut(Node * x, Node * y) {
  *                  the root node is reached.
  */
 
-template<typename T>
-void FibonacciHeap<T>::cascading_cut(Node * y) {
+template<typename T, template<typename> class Allocator>
+void FibonacciHeap<T, Allocator>::cascading_cut(Node * y) {
     
     Node * z {y->parent};
     
@@ -331,8 +334,8 @@ void FibonacciHeap<T>::cascading_cut(Node * y) {
  *  remove Node
  */
 
-template<typename T>
-void FibonacciHeap<T>::remove(Node * x) {
+template<typename T, template<typename> class Allocator>
+void FibonacciHeap<T, Allocator>::remove(Node * x) {
     
     decrease_key(x, INT_MIN);
     
@@ -340,15 +343,91 @@ void FibonacciHeap<T>::remove(Node * x) {
 }
 
 
-template<typename T>
-FibonacciHeap<T>::~FibonacciHeap() {
+/*
+ *  meld, splices the root list of other into this one; other's
+ *      allocator hands its nodes over, other is left empty
+ */
+
+template<typename T, template<typename> class Allocator>
+void FibonacciHeap<T, Allocator>::meld(FibonacciHeap &other) {
+    
+    if (&other == this || other.root == nullptr) return;
+    
+    alloc.absorb(other.alloc);
+    
+    if (root == nullptr) {
+        
+        root = other.root;
+    }
+    else {
+        
+        // root ... a and o ... b become root ... a o ... b
+        Node * a {root->left};
+        Node * o {other.root};
+        Node * b {o->left};
+        
+        a->right = o;
+        o->left = a;
+        b->right = root;
+        root->left = b;
+        
+        if (o->key < root->key)
+            root = o;
+    }
+    
+    N += other.N;
+    
+    other.root = nullptr;
+    other.N = 0;
+}
+
+
+template<typename T, template<typename> class Allocator>
+FibonacciHeap<T, Allocator>::~FibonacciHeap() {
     
-    deallocate(root);
+    // nodes in a pool are released together with the pool
+    if (!Allocator<Node>::bulk)
+        clear();
     
 }
 
-template<typename T>
-void FibonacciHeap<T>::deallocate(Node *x) {
+/*
+ *  clear, removes all nodes; O(1) when Allocator releases them in bulk
+ */
+
+template<typename T, template<typename> class Allocator>
+void FibonacciHeap<T, Allocator>::clear() {
+    
+    if (Allocator<Node>::bulk) {
+        
+        alloc.reset();
+        root = nullptr;
+    }
+    
+    // dealloc all the trees in the root list
+    while (root != nullptr) {
+        
+        Node * n {nullptr};
+        
+        if (root != root->right) {
+            
+            n = root->right;
+            
+            // remove from the list
+            root->right->left = root->left;
+            root->left->right = root->right;
+        }
+        
+        deallocate(root);
+        
+        root = n;
+    }
+    
+    N = 0;
+}
+
+template<typename T, template<typename> class Allocator>
+void FibonacciHeap<T, Allocator>::deallocate(Node *x) {
     
     if (x == nullptr) return;
     
@@ -373,15 +452,15 @@ void FibonacciHeap<T>::deallocate(Node *x) {
         c = n;
     }
     
-    delete x;
+    alloc.destroy(x);
 }
 
 /*
  *  Print out and debugging functions
  */
 
-template<typename T>
-void FibonacciHeap<T>::print(int level) {
+template<typename T, template<typename> class Allocator>
+void FibonacciHeap<T, Allocator>::print(int level) {
     
     std::cout << "Heap: n=" << N << " root node " << root << std::endl;
     std::cout << "root linked-list: " << std::endl;
@@ -395,8 +474,8 @@ void FibonacciHeap<T>::print(int level) {
 }
 
 
-template<typename T>
-void FibonacciHeap<T>::print_node(Node * n, int ntab, int level, bool print_children) {
+template<typename T, template<typename> class Allocator>
+void FibonacciHeap<T, Allocator>::print_node(Node * n, int ntab, int level, bool print_children) {
     
     for (int i=0; i<ntab; i++) std::cout << "\t";
     
@@ -432,8 +511,8 @@ void FibonacciHeap<T>::print_node(Node * n, int ntab, int level, bool print_chil
     }
 }
 
-template<typename T>
-void FibonacciHeap<T>::change_key(Node * x, int k) {
+template<typename T, template<typename> class Allocator>
+void FibonacciHeap<T, Allocator>::change_key(Node * x, int k) {
     if (x->key == k)
         throw "k is the same as x's key; that is not a key change";
     
@@ -471,6 +550,12 @@ void FibonacciHeap<T>::change_key(Node * x, int k) {
         
         x->child = nullptr;
         x->degree = 0;
+        
+        // x was the minimum, the new one is somewhere in the root list
+        if (root == x)
+            for (Node * w = x->right; w != x; w = w->right)
+                if (w->key < root->key)
+                    root = w;
     }
 }
 
@@ -478,3 +563,4 @@ void FibonacciHeap<T>::change_key(Node * x, int k) {
 
 // explicit instantiations
 template struct FibonacciHeap<int>;
+template struct FibonacciHeap<int, NewAllocator>;
@@ -14,7 +14,15 @@
 #include <cmath>
 #include <cassert>
 
-template<typename T>
+#include "../../Memory Pool/node-pool.hpp"
+
+/*
+ *  Nodes are created by Allocator, NodePool by default, see node-pool.hpp.
+ *  With NodePool clear() releases all the nodes in O(1), so one heap
+ *  can be reused between queries without freeing node by node.
+ */
+
+template<typename T, template<typename> class Allocator = NodePool>
 struct FibonacciHeap {
     
     struct Node {
@@ -41,9 +49,23 @@ struct FibonacciHeap {
         Node(int k, T v): key(k), value(v) {};
     };
     
+    /*
+     *  A node of degree d roots a tree of at least F(d+2) >= phi^d nodes,
+     *  so with N < 2^31 no degree is above log_phi(2^31) < 45
+     */
+    
+    enum { MAX_DEGREE = 45 };
+    
     int N{0};                   // number of nodes in the heap
     Node * root {nullptr};       // points to the root list with lowest key
     
+    Allocator<Node> alloc;      // creates and releases nodes
+    
+    // scratch of consolidate, kept between calls so that remove_min
+    // doesn't allocate
+    std::vector<Node *> root_list;
+    Node * by_degree[MAX_DEGREE] {};
+    
     /*
      *  Methods
      */
@@ -76,8 +98,17 @@ struct FibonacciHeap {
     
     void remove(Node * x);      // remove Node
     
+    void meld(FibonacciHeap &other);    // move all nodes of other to this heap, O(1)
+    
+    template<typename It>
+    void insert_range(It first, It last, Node ** nodes = nullptr);    // insert (key, value) pairs
+    
     int size() { return N; };
     
+    void reserve(int n) { alloc.reserve(n); };  // room for n nodes
+    
+    void clear();               // remove all nodes
+    
     /* priting/debugging functions */
     
     void print_node(Node * n, int ntab, int level, bool print_children=false);
@@ -86,6 +117,60 @@ struct FibonacciHeap {
 };
 
 
+/*
+ *  insert_range, inserts (key, value) pairs of [first, last); the new
+ *      nodes are linked into one list which is spliced into the root
+ *      list once. If nodes is given the i-th node is stored in nodes[i].
+ */
+
+template<typename T, template<typename> class Allocator>
+template<typename It>
+void FibonacciHeap<T, Allocator>::insert_range(It first, It last, Node ** nodes) {
+    
+    Node * head {nullptr};
+    Node * tail {nullptr};
+    Node * lowest {nullptr};
+    
+    for (; first != last; ++first) {
+        
+        Node * x = alloc.create(first->first, first->second);
+        
+        if (head == nullptr)
+            head = x;
+        else {
+            tail->right = x;
+            x->left = tail;
+        }
+        tail = x;
+        
+        if (lowest == nullptr || x->key < lowest->key)
+            lowest = x;
+        
+        if (nodes != nullptr)
+            *nodes++ = x;
+        
+        ++N;
+    }
+    
+    if (head == nullptr) return;
+    
+    if (root == nullptr) {
+        head->left = tail;
+        tail->right = head;
+        root = lowest;
+        return;
+    }
+    
+    // splice head..tail in front of root
+    head->left = root->left;
+    root->left->right = head;
+    tail->right = root;
+    root->left = tail;
+    
+    if (lowest->key < root->key)
+        root = lowest;
+}
+
 //#include "FibonacciHeap.tpp"
 
 #endif /* FibonacciHeap_hpp */
@@ -2,9 +2,12 @@
  
  Dijkstra’s algorithm
  
- Implementation using binary heap from std library,
- in efficient as decreasing key can't be done without
- reheapifying the heap;
+ Implementation using an indexed binary heap (Binary Heap/binary-heap.hpp).
+ The first version used make_heap from std library, which is inefficient
+ as decreasing key can't be done without reheapifying the whole heap.
+ The indexed heap keeps position of every vertex in the heap, so
+ decrease key is a single percolate up, and the algorithm runs in
+ O((V+E) log V). Vertices enter the heap only when they are reached.
  
  --------------------------------------------------------------------
 
@@ -56,6 +59,8 @@
 #include <algorithm>
 #include <climits>
 
+#include "dijkstras-stdlib-heap.hpp"
+
 using namespace std;
 
 struct Graph {
@@ -111,6 +116,21 @@ struct Graph {
         }
     }
     
+    /*
+     *  csr, copy of the graph in compressed sparse row form
+     */
+    
+    CSRGraph<int> csr() const {
+        
+        CSRGraph<int>::Builder b(n_v, edges.size());
+        
+        for (int i=0; i < n_v; i++)
+            for (Edge * e = vertex[i]; e != nullptr; e = e->next)
+                b.add(i, e->to, e->value);
+        
+        return b.build();
+    }
+    
     /*
      *  print
      */
@@ -130,63 +150,18 @@ struct Graph {
 };
 
 /*
- *  Dijkstra's algorithms using StdLib heap
+ *  Dijkstra's algorithms using indexed binary heap, see dijkstras-stdlib-heap.hpp
  */
 
 
-void dijkstras(const Graph &g, int s) {
+void dijkstras(const CSRGraph<int> &g, int s) {
 
     int n_v = g.n_vertices();
     
-    vector<int> pq(n_v); // priority queue with vertices ids
-    vector<int> dist(n_v);
-    vector<bool> visited(n_v, false);
-    vector<int> previous(n_v);
-    
-    for (int i=0; i < n_v; i++) {
-        pq[i] = i;
-        dist[i] = INT_MAX;
-        previous[i] = -1;
-    }
+    vector<int> dist;
+    vector<int> previous;
     
-    dist[s] = 0;
-    previous[s] = s;
-    
-    make_heap(pq.begin(), pq.end(), [dist] (int a, int b) { return dist[a] > dist[b]; });
-    
-    while (pq.size() > 0) {
-        
-        int v {pq[0]};
-        pop_heap(pq.begin(), pq.end());
-        pq.pop_back();
-        
-        visited[v] = true; // v is removed from heap, keeps track of
-                           // vertices on one side of the cut
-        
-        bool heapify{false}; // keeping track if heap was updated
-                             // so taht we don't unnecesserily heapify
-        
-        // Iterate over edges originating from v
-        // and update distance to end vertices
-        
-        auto e = g.vertex[v]; // first edge
-        while (e != nullptr) {
-            
-            int to {e->to}; // end vertex of the edge
-            
-            if (!visited[to] && dist[to] > dist[v] + e->value ) {
-                
-                dist[to] = dist[v] + e->value;
-                previous[to] = v;
-                
-                heapify = true;
-            }
-            e = e->next;
-        }
-        
-        if (heapify) // so that we don't heapify when there was no changes to pq
-            make_heap(pq.begin(), pq.end(), [dist] (int a, int b) { return dist[a] > dist[b]; });
-    }
+    dijkstras_binary_heap(g, s, dist, previous);
     
     
     // print shortest paths
@@ -203,6 +178,14 @@ void dijkstras(const Graph &g, int s) {
         }
 }
 
+/*
+ *  dijkstras on the linked-list Graph runs on its CSR copy
+ */
+
+void dijkstras(const Graph &g, int s) {
+    dijkstras(g.csr(), s);
+}
+
 
 int main(int argc, const char * argv[]) {
 
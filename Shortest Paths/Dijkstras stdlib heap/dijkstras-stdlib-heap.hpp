@@ -0,0 +1,66 @@
+//
+//  dijkstras-stdlib-heap.hpp
+//
+//  Created by mkuklik on 11/11/15.
+//  Copyright © 2015 mkuklik. All rights reserved.
+//
+
+#ifndef DijkstrasStdlibHeap_hpp
+#define DijkstrasStdlibHeap_hpp
+
+#include <vector>
+#include <climits>
+
+#include "../../Binary Heap/binary-heap.hpp"
+#include "../../CSR Graph/csr-graph.hpp"
+
+/*
+ *  Dijkstra's algorithms using indexed binary heap
+ *
+ *  dist[v] is INT_MAX and previous[v] is -1 if v is not reachable,
+ *  previous[s] is s
+ */
+
+
+inline void dijkstras_binary_heap(const CSRGraph<int> &g, int s,
+                                  std::vector<int> &dist, std::vector<int> &previous) {
+
+    int n_v = g.n_vertices();
+    
+    IndexedBinaryHeap<int> pq(n_v); // priority queue with vertices ids, keyed by distance
+    std::vector<bool> visited(n_v, false);
+    
+    dist.assign(n_v, INT_MAX);
+    previous.assign(n_v, -1);
+    
+    dist[s] = 0;
+    previous[s] = s;
+    
+    pq.insert(s, dist[s]);
+    
+    while (!pq.empty()) {
+        
+        int v {pq.pop()};
+        
+        visited[v] = true; // v is removed from heap, keeps track of
+                           // vertices on one side of the cut
+        
+        // Iterate over edges originating from v
+        // and update distance to end vertices
+        
+        for (int i = g.offset[v]; i < g.offset[v+1]; i++) {
+            
+            int to {g.target[i]}; // end vertex of the edge
+            
+            if (!visited[to] && dist[to] > dist[v] + g.value[i] ) {
+                
+                dist[to] = dist[v] + g.value[i];
+                previous[to] = v;
+                
+                pq.insert_or_decrease(to, dist[to]);  // update heap
+            }
+        }
+    }
+}
+
+#endif /* DijkstrasStdlibHeap_hpp */
@@ -0,0 +1,116 @@
+//
+//  johnson.cpp
+//
+//  All-pairs shortest paths with negative weights, see johnson.hpp
+//
+//  Created by mkuklik on 12/14/15.
+//  Copyright © 2015 mkuklik. All rights reserved.
+//
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <cstdlib>
+
+#include "johnson.hpp"
+
+using namespace std;
+
+
+void print(const DistanceMatrix &d) {
+
+    for (int u=0; u<d.rows(); u++) {
+        for (int v=0; v<d.cols(); v++) {
+            if (d(u, v) == INT_MAX)
+                cout << setw(5) << "inf";
+            else
+                cout << setw(5) << d(u, v);
+        }
+        cout << endl;
+    }
+}
+
+
+int main(int argc, const char * argv[]) {
+
+    // the matrix file is argv[1], or a temporary file removed at the end
+    string path = argc > 1 ? argv[1] : "/tmp/johnson-XXXXXX";
+
+    if (argc <= 1) {
+        int fd = mkstemp(&path[0]);
+        if (fd < 0) {
+            cout << "can't create temporary file" << endl;
+            return 1;
+        }
+        close(fd);
+    }
+
+    // Fig 25.6 p 702 in CLRS, vertices from 0
+
+    CSRGraph<int>::Builder b(5);
+    b.add(0,1,3);
+    b.add(0,2,8);
+    b.add(0,4,-4);
+    b.add(1,3,1);
+    b.add(1,4,7);
+    b.add(2,1,4);
+    b.add(3,0,2);
+    b.add(3,2,-5);
+    b.add(4,3,6);
+
+    CSRGraph<int> g = b.build();
+
+    DistanceMatrix d(g.n_vertices(), g.n_vertices());
+
+    if (!johnson(g, d)) {
+        cout << "negative cycle" << endl;
+        return 1;
+    }
+
+    cout << "in memory" << endl;
+    print(d);
+
+    // the same, bellman-ford from every vertex
+    BellmanFord bf(g);
+
+    for (int u=0; u<g.n_vertices(); u++) {
+        bf.shortestPathFrom(u);
+
+        for (int v=0; v<g.n_vertices(); v++)
+            if (bf.distances()[v] != d(u, v))
+                cout << "d(" << u << ", " << v << ") != bellman-ford " << bf.distances()[v] << endl;
+    }
+
+    // matrix in a file
+    DistanceMatrix f(g.n_vertices(), g.n_vertices(), path);
+
+    johnson(g, f, 2);
+    f.sync();
+
+    cout << "in " << path << endl;
+    print(f);
+
+    if (argc <= 1) unlink(path.c_str());
+
+    // negative cycle, 3 -> 2 -> 1 -> 3 weighs -1 with 2 -> 1 at 3
+    CSRGraph<int>::Builder c(5);
+    c.add(0,1,3);
+    c.add(1,3,1);
+    c.add(2,1,-3);
+    c.add(3,2,1);
+
+    CSRGraph<int> h = c.build();
+    DistanceMatrix dh(5, 5);
+    vector<int> cycle;
+
+    if (johnson(h, dh, 0, &cycle)) {
+        cout << "no negative cycle" << endl;
+    }
+    else {
+        cout << "negative cycle:";
+        for (auto v : cycle) cout << " " << v;
+        cout << endl;
+    }
+
+    return 0;
+}
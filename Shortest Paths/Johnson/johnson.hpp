@@ -0,0 +1,253 @@
+//
+//  johnson.hpp
+//
+//  Johnson's all-pairs shortest paths for sparse graphs with negative weights
+//
+//  Created by mkuklik on 12/14/15.
+//  Copyright © 2015 mkuklik. All rights reserved.
+//
+
+/*
+ *  Johnson's algorithm (Johnson 1977), CLRS 25.3
+ *
+ *  1. potentials h(v), shortest distances from a new vertex with zero
+ *     weight edges to all vertices; that's BellmanFord from all the
+ *     vertices as sources (SPFA mode), nothing is added to the graph.
+ *     A negative cycle anywhere shows up here and johnson stops.
+ *  2. reweighting, w'(u,v) = w(u,v) + h(u) - h(v) >= 0 by the triangle
+ *     inequality, and shortest paths stay the same: a u-v path gets
+ *     h(u) - h(v) longer whatever it is.
+ *  3. Dijkstra's from every vertex on the reweighted graph, rows are
+ *     independent and go to threads one at a time from a shared
+ *     counter as in batched_dijkstra (multi-source.hpp); every thread
+ *     has one heap and one row of 64-bit distances, as d'(u,v) can be
+ *     longer than d(u,v) by up to -h(v). A row is turned back into real
+ *     distances, d(u,v) = d'(u,v) - h(u) + h(v), while it's still in cache.
+ *
+ *  O(VE) for the potentials at worst, near-linear on mostly positive
+ *  weights, then O(V E log V) / threads.
+ *
+ *  DistanceMatrix, N x N 32-bit distances in one block, row-major,
+ *  INT_MAX where there's no path. It's in memory, or in a file mapped
+ *  with mmap (MAP_SHARED): the OS writes pages back to the file and
+ *  drops them under memory pressure, so matrices bigger than RAM
+ *  work. The file is just the matrix, rows * cols ints in the byte
+ *  order of the machine, no header.
+ */
+
+#ifndef Johnson_hpp
+#define Johnson_hpp
+
+#include <vector>
+#include <string>
+#include <atomic>
+#include <thread>
+#include <climits>
+#include <algorithm>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include "../../CSR Graph/csr-graph.hpp"
+#include "../Bellman Ford/bellman-ford.hpp"
+#include "../../Binary Heap/binary-heap.hpp"
+
+class DistanceMatrix {
+
+    int R {0};
+    int C {0};
+
+    std::vector<int> mem;
+    int * p {nullptr};
+    size_t bytes {0};
+    bool mapped {false};
+
+public:
+
+    /*
+     *  in memory, zeros
+     */
+
+    DistanceMatrix(int rows, int cols): R(rows), C(cols), mem((size_t) rows * cols, 0) {
+        p = mem.data();
+    };
+
+    /*
+     *  in the file at path, created or truncated; zeros until written,
+     *  pages of the file are allocated when they are
+     */
+
+    DistanceMatrix(int rows, int cols, const std::string &path): R(rows), C(cols) {
+
+        bytes = (size_t) rows * cols * sizeof(int);
+
+        int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) throw "distance matrix: can't open file";
+
+        if (ftruncate(fd, (off_t) bytes) != 0) {
+            ::close(fd);
+            throw "distance matrix: can't resize file";
+        }
+
+        if (bytes > 0) {
+            void * m = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+            if (m == MAP_FAILED) {
+                ::close(fd);
+                throw "distance matrix: mmap failed";
+            }
+            p = (int *) m;
+            mapped = true;
+        }
+
+        ::close(fd);    // mapping stays valid
+    }
+
+    DistanceMatrix(const DistanceMatrix &) = delete;
+    DistanceMatrix & operator=(const DistanceMatrix &) = delete;
+
+    ~DistanceMatrix() {
+        if (mapped) munmap(p, bytes);
+    }
+
+    int rows() const { return R; }
+    int cols() const { return C; }
+
+    int * row(int i) { return p + (size_t) i * C; }
+    const int * row(int i) const { return p + (size_t) i * C; }
+
+    int operator()(int i, int j) const { return p[(size_t) i * C + j]; }
+
+    int * data() { return p; }
+
+    bool in_file() const { return mapped; }
+
+    /*
+     *  sync, writes the mapped matrix to the file and waits for it
+     */
+
+    void sync() {
+        if (mapped && msync(p, bytes, MS_SYNC) != 0) throw "distance matrix: msync failed";
+    }
+};
+
+/*
+ *  johnson_row, Dijkstra's from s on the reweighted graph into dist,
+ *      LLONG_MAX where there's no path. Sums are 64-bit, a reweighted
+ *      edge or distance is up to -h(v) longer than the real one and
+ *      needn't fit in int.
+ */
+
+inline void johnson_row(const CSRGraph<long long> &r, int s, IndexedBinaryHeap<long long> &pq,
+                        std::vector<long long> &dist) {
+
+    std::fill(dist.begin(), dist.end(), LLONG_MAX);
+
+    dist[s] = 0;
+    pq.insert(s, 0);
+
+    while (!pq.empty()) {
+
+        int v {pq.pop()};
+
+        for (int i = r.offset[v]; i < r.offset[v+1]; i++) {
+
+            int to {r.target[i]};
+            long long d {dist[v] + r.value[i]};
+
+            if (d < dist[to]) {
+                dist[to] = d;
+                pq.insert_or_decrease(to, d);
+            }
+        }
+    }
+}
+
+/*
+ *  johnson, d(u, v) for all pairs into the N x N matrix d; false and d
+ *      unchanged if there's a negative cycle, its vertices go to cycle
+ *      if it's not nullptr (as BellmanFord::negative_cycle). n_threads
+ *      0 uses all cores. Throws if a distance doesn't fit in int.
+ */
+
+inline bool johnson(const CSRGraph<int> &g, DistanceMatrix &d, int n_threads = 0,
+                    std::vector<int> * cycle = nullptr) {
+
+    const int n_v = g.n_vertices();
+
+    if (d.rows() != n_v || d.cols() != n_v) throw "johnson: matrix is not N x N";
+
+    // potentials
+
+    std::vector<int> all(n_v);
+    for (int v=0; v<n_v; v++) all[v] = v;
+
+    BellmanFord bf(g);
+    if (!bf.shortestPathFrom(all, SPFA)) {
+        if (cycle != nullptr) *cycle = bf.negative_cycle();
+        return false;
+    }
+
+    const std::vector<int> &h = bf.distances();
+
+    // reweighted graph, offset and target are views of those of g
+
+    CSRGraph<long long> r(n_v);
+    r.offset = CSRArray<int>::view(g.offset.data(), g.offset.size());
+    r.target = CSRArray<int>::view(g.target.data(), g.target.size());
+    r.value = CSRArray<long long>(g.n_edges());
+
+    for (int u=0; u<n_v; u++)
+        for (int i=g.offset[u]; i<g.offset[u+1]; i++)
+            r.value[i] = (long long) g.value[i] + h[u] - h[g.target[i]];
+
+    // Dijkstra's from every vertex
+
+    if (n_threads <= 0)
+        n_threads = std::max(1u, std::thread::hardware_concurrency());
+    n_threads = std::max(1, std::min(n_threads, n_v));
+
+    std::atomic<int> next {0};
+    std::atomic<bool> too_long {false};    // threads can't throw
+
+    auto work = [&] {
+
+        IndexedBinaryHeap<long long> pq(n_v);
+        std::vector<long long> dist(n_v);
+
+        for (int u = next++; u < n_v; u = next++) {
+
+            johnson_row(r, u, pq, dist);
+
+            int * row = d.row(u);
+
+            for (int v=0; v<n_v; v++) {
+
+                if (dist[v] == LLONG_MAX) {
+                    row[v] = INT_MAX;
+                    continue;
+                }
+
+                long long x = dist[v] - h[u] + h[v];
+                if (x < INT_MIN || x >= INT_MAX) too_long = true;
+                row[v] = (int) x;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int t=1; t<n_threads; t++)
+        threads.push_back(std::thread(work));
+
+    work();
+
+    for (auto &th : threads)
+        th.join();
+
+    if (too_long) throw "johnson: distance doesn't fit in int";
+
+    return true;
+}
+
+#endif /* Johnson_hpp */
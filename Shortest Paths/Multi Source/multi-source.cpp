@@ -0,0 +1,84 @@
+//
+//  multi-source.cpp
+//
+//  Nearest of several sources and distances from each of them,
+//  see multi-source.hpp
+//
+//  Created by mkuklik on 12/11/15.
+//  Copyright © 2015 mkuklik. All rights reserved.
+//
+
+#include <iostream>
+#include <vector>
+
+#include "multi-source.hpp"
+#include "../Dijkstras stdlib heap/dijkstras-stdlib-heap.hpp"
+#include "../Bellman Ford/bellman-ford.hpp"
+
+using namespace std;
+
+
+int main(int argc, const char * argv[]) {
+
+    CSRGraph<int>::Builder b(9);
+    b.add(0,1,4);
+    b.add(0,7,8);
+    b.add(1,2,8);
+    b.add(2,3,7);
+    b.add(2,5,4);
+    b.add(2,8,2);
+    b.add(7,8,7);
+    b.add(7,1,11);
+    b.add(7,6,1);
+    b.add(6,5,2);
+    b.add(6,8,6);
+    b.add(5,3,14);
+    b.add(5,4,10);
+    b.add(3,4,9);
+
+    CSRGraph<int> g = b.build();
+
+    vector<int> depots {0, 6};
+
+    // nearest depot
+
+    vector<int> dist, previous, origin;
+    multi_source_dijkstra(g, depots, dist, previous, origin);
+
+    BellmanFord bf(g);
+    bf.shortestPathFrom(depots);
+
+    cout << "nearest of 0, 6" << endl;
+
+    for (int v=0; v<g.n_vertices(); v++) {
+
+        cout << v << ": d(" << dist[v] << ") from " << origin[v];
+
+        if (dist[v] != bf.distances()[v] || origin[v] != bf.origins()[v])
+            cout << " != bellman-ford";
+
+        cout << endl;
+    }
+
+    // distances from every depot, one row per depot
+
+    vector<int> rows, prev_rows;
+    batched_dijkstra(g, depots, rows, prev_rows);
+
+    for (size_t k=0; k<depots.size(); k++) {
+
+        dijkstras_binary_heap(g, depots[k], dist, previous);
+
+        cout << "from " << depots[k] << ":";
+
+        for (int v=0; v<g.n_vertices(); v++) {
+            int d = rows[k * g.n_vertices() + v];
+            cout << " " << (d == INT_MAX ? -1 : d);
+            if (d != dist[v]) cout << "(!= " << dist[v] << ")";
+        }
+
+        cout << endl;
+    }
+
+    return 0;
+}
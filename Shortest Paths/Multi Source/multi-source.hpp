@@ -0,0 +1,189 @@
+//
+//  multi-source.hpp
+//
+//  Shortest paths from many sources: nearest source and all of K sources
+//
+//  Created by mkuklik on 12/11/15.
+//  Copyright © 2015 mkuklik. All rights reserved.
+//
+
+/*
+ *  multi_source_dijkstra, distances to the nearest of a set of sources,
+ *  e.g. depots. It's Dijkstra's algorithm from a super-source with a
+ *  zero weight edge to every source, without adding it to the graph:
+ *  all sources start in the heap at distance 0. origin[v] is the source
+ *  whose shortest path tree v ends up in, i.e. the nearest one, and
+ *  it's passed along with previous when an edge is relaxed.
+ *
+ *  batched_dijkstra, full distances from each of K sources, row k of
+ *  the K x N result is sources[k]. Sources are independent; threads
+ *  take them one at a time from a shared counter and write their rows
+ *  directly. The graph is shared read-only, every thread keeps one
+ *  heap for all its sources, there's no allocation per source. Rows
+ *  are the same whatever the number of threads.
+ *
+ *  Both are for non-negative weights; BellmanFord::shortestPathFrom
+ *  (bellman-ford.hpp) takes a set of sources too.
+ */
+
+#ifndef MultiSource_hpp
+#define MultiSource_hpp
+
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <utility>
+#include <climits>
+#include <algorithm>
+
+#include "../../Binary Heap/binary-heap.hpp"
+#include "../../CSR Graph/csr-graph.hpp"
+
+/*
+ *  multi_source_dijkstra, dist[v] distance to the nearest source,
+ *      origin[v] that source, previous[v] vertex before v on the path
+ *      from it; previous[s] = origin[s] = s for sources, dist is
+ *      INT_MAX and previous, origin -1 if v is not reachable
+ */
+
+inline void multi_source_dijkstra(const CSRGraph<int> &g, const std::vector<int> &sources,
+                                  std::vector<int> &dist, std::vector<int> &previous,
+                                  std::vector<int> &origin) {
+
+    int n_v = g.n_vertices();
+
+    IndexedBinaryHeap<int> pq(n_v);
+
+    dist.assign(n_v, INT_MAX);
+    previous.assign(n_v, -1);
+    origin.assign(n_v, -1);
+
+    std::vector<std::pair<int, int>> seeds;
+    seeds.reserve(sources.size());
+
+    for (auto s : sources) {
+        if (s < 0 || s >= n_v) throw "multi_source_dijkstra: source out of range";
+        if (origin[s] >= 0) continue;   // listed twice
+
+        dist[s] = 0;
+        previous[s] = s;
+        origin[s] = s;
+        seeds.push_back(std::make_pair(s, 0));
+    }
+
+    pq.insert_range(seeds.begin(), seeds.end());
+
+    while (!pq.empty()) {
+
+        int v {pq.pop()};
+
+        // settled vertices never pass the test, weights are non-negative
+        for (int i = g.offset[v]; i < g.offset[v+1]; i++) {
+
+            int to {g.target[i]};
+            int d {dist[v] + g.value[i]};
+
+            if (d < dist[to]) {
+                dist[to] = d;
+                previous[to] = v;
+                origin[to] = origin[v];
+                pq.insert_or_decrease(to, d);
+            }
+        }
+    }
+}
+
+namespace multi_source {
+
+    /*
+     *  dijkstra_row, Dijkstra's from s into dist[0..N) and previous[0..N)
+     *      (previous can be nullptr), with the heap of the caller
+     */
+
+    inline void dijkstra_row(const CSRGraph<int> &g, int s, IndexedBinaryHeap<int> &pq,
+                             int * dist, int * previous) {
+
+        int n_v = g.n_vertices();
+
+        std::fill(dist, dist + n_v, INT_MAX);
+        if (previous != nullptr)
+            std::fill(previous, previous + n_v, -1);
+
+        dist[s] = 0;
+        if (previous != nullptr) previous[s] = s;
+
+        pq.insert(s, 0);
+
+        while (!pq.empty()) {
+
+            int v {pq.pop()};
+
+            for (int i = g.offset[v]; i < g.offset[v+1]; i++) {
+
+                int to {g.target[i]};
+                int d {dist[v] + g.value[i]};
+
+                if (d < dist[to]) {
+                    dist[to] = d;
+                    if (previous != nullptr) previous[to] = v;
+                    pq.insert_or_decrease(to, d);
+                }
+            }
+        }
+    }
+}
+
+/*
+ *  batched_dijkstra, shortest paths from every source; row k of dist
+ *      (and previous, if not nullptr), N = g.n_vertices() entries
+ *      starting at k * N, is for sources[k], as in
+ *      dijkstras_binary_heap. n_threads 0 uses all cores.
+ */
+
+inline void batched_dijkstra(const CSRGraph<int> &g, const std::vector<int> &sources,
+                             int * dist, int * previous, int n_threads = 0) {
+
+    const int n_v = g.n_vertices();
+    const int k = (int) sources.size();
+
+    for (auto s : sources)
+        if (s < 0 || s >= n_v) throw "batched_dijkstra: source out of range";
+
+    if (n_threads <= 0)
+        n_threads = std::max(1u, std::thread::hardware_concurrency());
+    n_threads = std::max(1, std::min(n_threads, k));
+
+    std::atomic<int> next {0};
+
+    auto work = [&] {
+
+        IndexedBinaryHeap<int> pq(n_v);
+
+        for (int i = next++; i < k; i = next++)
+            multi_source::dijkstra_row(g, sources[i], pq, dist + (size_t) i * n_v,
+                                       previous == nullptr ? nullptr : previous + (size_t) i * n_v);
+    };
+
+    std::vector<std::thread> threads;
+    for (int t=1; t<n_threads; t++)
+        threads.push_back(std::thread(work));
+
+    work();
+
+    for (auto &th : threads)
+        th.join();
+}
+
+inline void batched_dijkstra(const CSRGraph<int> &g, const std::vector<int> &sources,
+                             std::vector<int> &dist, std::vector<int> &previous,
+                             int n_threads = 0) {
+
+    size_t cells = sources.size() * (size_t) g.n_vertices();
+
+    dist.resize(cells);
+    previous.resize(cells);
+
+    batched_dijkstra(g, sources, dist.data(), previous.data(), n_threads);
+}
+
+#endif /* MultiSource_hpp */